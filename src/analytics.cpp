@@ -0,0 +1,197 @@
+#include "analytics.h"
+#include "utility.h"
+#include "skill_ontology.h"
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+#include <cctype>
+using namespace std;
+
+// Job descriptions keep the CSV quotes, so the title can start with one
+static string cleanTitle(const string &title) {
+    size_t first = title.find_first_not_of("\" ");
+    if (first == string::npos) return string();
+    size_t last = title.find_last_not_of("\" ");
+    return title.substr(first, last - first + 1);
+}
+
+// ---------------- map ----------------
+void SkillTally::addJob(const string &rawTitle, const string keywords[10]) {
+    jobCount++;
+    string title = cleanTitle(rawTitle);
+    string key = lowercase(title);
+    unordered_map<string, Title>::iterator t = titles.find(key);
+    if (t == titles.end()) {
+        Title fresh;
+        fresh.name = title;
+        fresh.jobs = 0;
+        t = titles.insert(make_pair(key, fresh)).first;
+    }
+    t->second.jobs++;
+
+    for (int i = 0; i < 10; ++i) {
+        if (keywords[i].empty()) continue;
+        string skill = lowercase(keywords[i]);
+        if (isStopWord(skill)) continue;   // "Mr", "our", ...
+        bool repeated = false;             // a job listing a skill twice needs it once
+        for (int k = 0; k < i && !repeated; ++k) repeated = equalsIgnoreCase(keywords[k], keywords[i]);
+        if (repeated) continue;
+
+        Count &c = t->second.skills[skill];
+        if (c.name.empty()) { c.name = keywords[i]; c.count = 0; }
+        c.count++;
+    }
+}
+
+void SkillTally::addResume(const string keywords[10]) {
+    resumeCount++;
+    for (int i = 0; i < 10; ++i) {
+        if (keywords[i].empty()) continue;
+        string skill = lowercase(keywords[i]);
+        if (isStopWord(skill)) continue;
+        bool repeated = false;
+        for (int k = 0; k < i && !repeated; ++k) repeated = equalsIgnoreCase(keywords[k], keywords[i]);
+        if (repeated) continue;
+
+        Count &c = supply[skill];
+        if (c.name.empty()) { c.name = keywords[i]; c.count = 0; }
+        c.count++;
+    }
+}
+
+// ---------------- reduce ----------------
+void SkillTally::merge(const SkillTally &other) {
+    jobCount += other.jobCount;
+    resumeCount += other.resumeCount;
+    for (unordered_map<string, Title>::const_iterator t = other.titles.begin(); t != other.titles.end(); ++t) {
+        Title &mine = titles[t->first];
+        if (mine.name.empty()) { mine.name = t->second.name; mine.jobs = 0; }
+        mine.jobs += t->second.jobs;
+        for (unordered_map<string, Count>::const_iterator s = t->second.skills.begin(); s != t->second.skills.end(); ++s) {
+            Count &c = mine.skills[s->first];
+            if (c.name.empty()) { c.name = s->second.name; c.count = 0; }
+            c.count += s->second.count;
+        }
+    }
+    for (unordered_map<string, Count>::const_iterator s = other.supply.begin(); s != other.supply.end(); ++s) {
+        Count &c = supply[s->first];
+        if (c.name.empty()) { c.name = s->second.name; c.count = 0; }
+        c.count += s->second.count;
+    }
+}
+
+static bool moreDemanded(const SkillDemand &a, const SkillDemand &b) {
+    return a.jobs != b.jobs ? a.jobs > b.jobs : a.skill < b.skill;
+}
+
+void SkillTally::finish(SkillAnalytics &out) const {
+    out.jobCount = jobCount;
+    out.resumeCount = resumeCount;
+    out.titles.clear();
+    out.overall.clear();
+
+    unordered_map<string, SkillDemand> totals;
+    for (unordered_map<string, Title>::const_iterator t = titles.begin(); t != titles.end(); ++t) {
+        TitleDemand title;
+        title.title = t->second.name;
+        title.jobs = t->second.jobs;
+        for (unordered_map<string, Count>::const_iterator s = t->second.skills.begin(); s != t->second.skills.end(); ++s) {
+            unordered_map<string, Count>::const_iterator have = supply.find(s->first);
+            SkillDemand d = { s->second.name, s->second.count, have == supply.end() ? 0 : have->second.count };
+            title.skills.push_back(d);
+
+            SkillDemand &total = totals[s->first];
+            if (total.skill.empty()) { total.skill = d.skill; total.jobs = 0; total.resumes = d.resumes; }
+            total.jobs += d.jobs;
+        }
+        sort(title.skills.begin(), title.skills.end(), moreDemanded);
+        out.titles.push_back(title);
+    }
+    sort(out.titles.begin(), out.titles.end(), [](const TitleDemand &a, const TitleDemand &b) {
+        return a.title < b.title;
+    });
+
+    for (unordered_map<string, SkillDemand>::const_iterator s = totals.begin(); s != totals.end(); ++s)
+        out.overall.push_back(s->second);
+    sort(out.overall.begin(), out.overall.end(), moreDemanded);
+}
+
+// ---------------- output ----------------
+static string csvField(const string &text) {
+    if (text.find_first_of(",\"\n") == string::npos) return text;
+    string quoted = "\"";
+    for (size_t i = 0; i < text.size(); ++i) {
+        if (text[i] == '"') quoted += '"';
+        quoted += text[i];
+    }
+    return quoted + "\"";
+}
+
+bool SkillAnalytics::writeCSV(const string &filename) const {
+    ofstream out(filename.c_str());
+    if (!out) return false;
+    out << "title,skill,title_jobs,demand_jobs,supply_resumes,supply_demand_ratio\n";
+    for (size_t i = 0; i < overall.size(); ++i)
+        out << "(all titles)," << csvField(overall[i].skill) << "," << jobCount << "," << overall[i].jobs
+            << "," << overall[i].resumes << "," << overall[i].ratio() << "\n";
+    for (size_t t = 0; t < titles.size(); ++t)
+        for (size_t i = 0; i < titles[t].skills.size(); ++i) {
+            const SkillDemand &d = titles[t].skills[i];
+            out << csvField(titles[t].title) << "," << csvField(d.skill) << "," << titles[t].jobs << ","
+                << d.jobs << "," << d.resumes << "," << d.ratio() << "\n";
+        }
+    return (bool)out;
+}
+
+void SkillAnalytics::printSummary(int top) const {
+    cout << jobCount << " jobs under " << titles.size() << " titles, " << resumeCount << " resumes, "
+         << overall.size() << " demanded skills\n";
+
+    // Scarcest first among skills that a meaningful number of jobs ask for
+    int minDemand = max(1, jobCount / 100);
+    vector<SkillDemand> scarce;
+    for (size_t i = 0; i < overall.size(); ++i)
+        if (overall[i].jobs >= minDemand) scarce.push_back(overall[i]);
+    sort(scarce.begin(), scarce.end(), [](const SkillDemand &a, const SkillDemand &b) {
+        return a.ratio() != b.ratio() ? a.ratio() < b.ratio() : a.jobs > b.jobs;
+    });
+
+    cout << fixed << setprecision(2);
+    cout << "\nMost under-supplied skills (resumes per job needing them, demand >= " << minDemand << "):\n";
+    for (int i = 0; i < top && i < (int)scarce.size(); ++i)
+        cout << "  " << scarce[i].skill << ": " << scarce[i].jobs << " jobs, " << scarce[i].resumes
+             << " resumes (" << scarce[i].ratio() << ")\n";
+
+    vector<const TitleDemand*> largest;
+    for (size_t t = 0; t < titles.size(); ++t) largest.push_back(&titles[t]);
+    sort(largest.begin(), largest.end(), [](const TitleDemand *a, const TitleDemand *b) {
+        return a->jobs != b->jobs ? a->jobs > b->jobs : a->title < b->title;
+    });
+    cout << "\nLargest titles (top skill demand):\n";
+    for (int i = 0; i < top && i < (int)largest.size(); ++i) {
+        cout << "  " << largest[i]->title << ": " << largest[i]->jobs << " jobs";
+        if (!largest[i]->skills.empty())
+            cout << ", most need " << largest[i]->skills[0].skill << " (" << largest[i]->skills[0].jobs << ")";
+        cout << "\n";
+    }
+    cout.unsetf(ios::floatfield);
+    cout << setprecision(6);
+}
+
+void SkillAnalytics::printLookup(const string &title, const string &term) const {
+    const string skill = SkillOntology::canonical(term);   // tallies are keyed by canonical skill
+    for (size_t t = 0; t < titles.size(); ++t) {
+        if (!equalsIgnoreCase(titles[t].title, title)) continue;
+        for (size_t i = 0; i < titles[t].skills.size(); ++i) {
+            const SkillDemand &d = titles[t].skills[i];
+            if (!equalsIgnoreCase(d.skill, skill)) continue;
+            cout << d.jobs << " of " << titles[t].jobs << " \"" << titles[t].title << "\" jobs need " << d.skill
+                 << "; " << d.resumes << " resumes list it (" << d.ratio() << " per job)\n";
+            return;
+        }
+        cout << "No \"" << titles[t].title << "\" job asks for " << skill << ".\n";
+        return;
+    }
+    cout << "No job is titled \"" << title << "\".\n";
+}
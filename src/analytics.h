@@ -0,0 +1,125 @@
+#ifndef ANALYTICS_H
+#define ANALYTICS_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <chrono>
+#include "parallel.h"
+#include "metrics.h"
+#include "trace.h"
+using namespace std;
+
+// Skill demand / supply analytics ("how many Data Scientist jobs need
+// PyTorch, and how many resumes have it?"). Jobs are grouped by the title
+// extractInfo() found; for every title the number of its jobs listing each
+// skill is the demand, the number of resumes listing the skill anywhere is
+// the supply. Computed as one parallel map-reduce over the in-memory store:
+// each thread tallies a slice of the records into its own SkillTally, the
+// tallies are merged, and the result is sorted once.
+
+struct SkillDemand {
+    string skill;
+    int jobs;         // demand: jobs listing the skill
+    int resumes;      // supply: resumes listing the skill
+    double ratio() const { return jobs ? (double)resumes / jobs : 0.0; }
+};
+
+struct TitleDemand {
+    string title;
+    int jobs;                      // jobs with this title
+    vector<SkillDemand> skills;    // most demanded first
+};
+
+class SkillAnalytics {
+public:
+    vector<TitleDemand> titles;    // alphabetical
+    vector<SkillDemand> overall;   // demand over every title, most demanded first
+    int jobCount;
+    int resumeCount;
+    int workers;
+    long long micros;
+
+    SkillAnalytics() : jobCount(0), resumeCount(0), workers(1), micros(0) {}
+
+    // title,skill,title_jobs,demand_jobs,supply_resumes,supply_demand_ratio
+    // (one row per title and skill, plus "(all titles)" rows for the totals)
+    bool writeCSV(const string &filename) const;
+
+    // Counts, the most under-supplied skills and the largest titles
+    void printSummary(int top) const;
+
+    // Demand and supply for one title (case-insensitive) and skill (an alias is accepted)
+    void printLookup(const string &title, const string &term) const;
+};
+
+// Per-thread partial counts; keys are lowercase, values keep the first spelling seen
+class SkillTally {
+private:
+    struct Count { string name; int count; };
+    struct Title { string name; int jobs; unordered_map<string, Count> skills; };
+
+    unordered_map<string, Title> titles;
+    unordered_map<string, Count> supply;
+    int jobCount;
+    int resumeCount;
+
+public:
+    SkillTally() : jobCount(0), resumeCount(0) {}
+
+    void addJob(const string &title, const string keywords[10]);
+    void addResume(const string keywords[10]);
+    void merge(const SkillTally &other);   // other's records come after this one's
+    void finish(SkillAnalytics &out) const;
+};
+
+// Map-reduce over both stores (any RecordStore backend)
+template <class JobStore, class ResumeStore>
+SkillAnalytics computeSkillAnalytics(const JobStore &jobs, const ResumeStore &resumes) {
+    using namespace std::chrono;
+    TRACE_SCOPE("skillAnalytics");
+    auto start = high_resolution_clock::now();
+
+    // Lists cannot be split by position, so every backend is first flattened
+    // into record pointers with one walk; the slices then index into those
+    vector<const typename JobStore::record_type*> jobRecords;
+    vector<const typename ResumeStore::record_type*> resumeRecords;
+    jobRecords.reserve(jobs.size());
+    resumeRecords.reserve(resumes.size());
+    for (typename JobStore::const_iterator j = jobs.begin(); j != jobs.end(); ++j) jobRecords.push_back(&*j);
+    for (typename ResumeStore::const_iterator r = resumes.begin(); r != resumes.end(); ++r) resumeRecords.push_back(&*r);
+
+    int jobWorkers = parallelWorkers((int)jobRecords.size());
+    int resumeWorkers = parallelWorkers((int)resumeRecords.size());
+    int workers = max(jobWorkers, resumeWorkers);
+    vector<SkillTally> tallies(workers);
+    int jobChunk = ((int)jobRecords.size() + jobWorkers - 1) / jobWorkers;
+    int resumeChunk = ((int)resumeRecords.size() + resumeWorkers - 1) / resumeWorkers;
+
+    // Map: thread w tallies slice w of the jobs and slice w of the resumes
+    runOnThreads(workers, "analytics worker", [&](int w) {
+        TRACE_SCOPE("tally");
+        SkillTally &tally = tallies[w];
+        int jobEnd = min((int)jobRecords.size(), (w + 1) * jobChunk);
+        for (int i = w * jobChunk; i < jobEnd; ++i)
+            tally.addJob(jobRecords[i]->title, jobRecords[i]->keywords);
+        int resumeEnd = min((int)resumeRecords.size(), (w + 1) * resumeChunk);
+        for (int i = w * resumeChunk; i < resumeEnd; ++i)
+            tally.addResume(resumeRecords[i]->keywords);
+    });
+
+    // Reduce in slice order so the first spelling in store order wins
+    SkillAnalytics result;
+    {
+        TRACE_SCOPE("merge");
+        for (int w = 1; w < workers; ++w) tallies[0].merge(tallies[w]);
+        tallies[0].finish(result);
+    }
+    result.workers = workers;
+    result.micros = duration_cast<microseconds>(high_resolution_clock::now() - start).count();
+    recordLatency("analytics", ResumeStore::backendName(), result.micros);
+    return result;
+}
+
+#endif
@@ -0,0 +1,237 @@
+#include "autocomplete.h"
+#include "utility.h"
+#include <iostream>
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+using namespace std;
+using namespace std::chrono;
+
+// Job titles keep the CSV quote and stray spaces; drop them
+static string cleanTerm(const string &s) {
+    size_t start = s.find_first_not_of(" \"");
+    if (start == string::npos) return "";
+    size_t end = s.find_last_not_of(" \"");
+    return s.substr(start, end - start + 1);
+}
+
+PrefixCompleter::PrefixCompleter(Source src) : source(src) {
+    newNode('\0');
+}
+
+// ---------------- trie structure ----------------
+int PrefixCompleter::newNode(char ch) {
+    TrieNode n;
+    n.ch = ch;
+    n.firstChild = -1;
+    n.nextSibling = -1;
+    n.termID = -1;
+    n.dirty = false;
+    n.topCount = 0;
+    nodes.push_back(n);
+    return (int)nodes.size() - 1;
+}
+
+int PrefixCompleter::findChild(int node, char ch) const {
+    for (int c = nodes[node].firstChild; c != -1; c = nodes[c].nextSibling)
+        if (nodes[c].ch == ch) return c;
+    return -1;
+}
+
+int PrefixCompleter::findOrAddChild(int node, char ch) {
+    int c = findChild(node, ch);
+    if (c != -1) return c;
+    c = newNode(ch);                        // may reallocate nodes
+    nodes[c].nextSibling = nodes[node].firstChild;
+    nodes[node].firstChild = c;
+    return c;
+}
+
+int PrefixCompleter::findNode(const string &folded) const {
+    int node = 0;
+    for (size_t i = 0; i < folded.size() && node != -1; ++i)
+        node = findChild(node, folded[i]);
+    return node;
+}
+
+// ---------------- ranking ----------------
+bool PrefixCompleter::ranksBefore(int a, int b) const {
+    if (frequency[a] != frequency[b]) return frequency[a] > frequency[b];
+    return a < b;   // ties: first seen wins
+}
+
+// Term's frequency went up: make sure it sits in the right place of node's list
+void PrefixCompleter::promote(TrieNode &node, int termID) {
+    int pos = -1;
+    for (int i = 0; i < node.topCount; ++i)
+        if (node.top[i] == termID) { pos = i; break; }
+
+    if (pos == -1) {
+        if (node.topCount < TOP_K) {
+            pos = node.topCount++;
+        } else if (ranksBefore(termID, node.top[TOP_K - 1])) {
+            pos = TOP_K - 1;
+        } else {
+            return;
+        }
+        node.top[pos] = termID;
+    }
+
+    while (pos > 0 && ranksBefore(node.top[pos], node.top[pos - 1])) {
+        swap(node.top[pos], node.top[pos - 1]);
+        pos--;
+    }
+}
+
+// Recompute node's top list from its whole subtree (only needed after removals)
+void PrefixCompleter::rebuild(int node) {
+    vector<int> found;
+    vector<int> stack;
+    if (nodes[node].termID != -1) found.push_back(nodes[node].termID);
+    if (nodes[node].firstChild != -1) stack.push_back(nodes[node].firstChild);
+
+    while (!stack.empty()) {
+        int n = stack.back();
+        stack.pop_back();
+        if (nodes[n].termID != -1) found.push_back(nodes[n].termID);
+        if (nodes[n].nextSibling != -1) stack.push_back(nodes[n].nextSibling);
+        if (nodes[n].firstChild != -1) stack.push_back(nodes[n].firstChild);
+    }
+
+    found.erase(remove_if(found.begin(), found.end(),
+                          [this](int t) { return frequency[t] <= 0; }), found.end());
+    size_t keep = min(found.size(), (size_t)TOP_K);
+    partial_sort(found.begin(), found.begin() + keep, found.end(),
+                 [this](int a, int b) { return ranksBefore(a, b); });
+
+    TrieNode &n = nodes[node];
+    n.topCount = (int)keep;
+    for (size_t i = 0; i < keep; ++i) n.top[i] = found[i];
+    n.dirty = false;
+}
+
+// ---------------- updates ----------------
+void PrefixCompleter::addTerm(const string &raw, int delta) {
+    string term = cleanTerm(raw);
+    if (term.empty()) return;
+    string folded = lowercase(term);
+
+    int termID;
+    unordered_map<string, int>::iterator it = termIDs.find(folded);
+    if (it != termIDs.end()) {
+        termID = it->second;
+    } else {
+        if (delta < 0) return;
+        termID = (int)terms.size();
+        termIDs[folded] = termID;
+        terms.push_back(term);
+        frequency.push_back(0);
+    }
+    frequency[termID] += delta;
+
+    // Walk root -> end of term, fixing each cached top list on the way
+    int node = 0;
+    for (size_t i = 0; ; ++i) {
+        TrieNode &n = nodes[node];
+        if (delta > 0) {
+            if (!n.dirty) promote(n, termID);
+        } else {
+            for (int k = 0; k < n.topCount; ++k)
+                if (n.top[k] == termID) { n.dirty = true; break; }
+        }
+        if (i == folded.size()) break;
+        node = (delta > 0) ? findOrAddChild(node, folded[i]) : findChild(node, folded[i]);
+        if (node == -1) return;
+    }
+    nodes[node].termID = termID;
+}
+
+void PrefixCompleter::feed(const string &title, const string keywords[10], int delta) {
+    if (source == TITLES) {
+        addTerm(title, delta);
+        return;
+    }
+    // Count each skill once per record even if it is listed twice
+    for (int i = 0; i < 10; ++i) {
+        if (keywords[i].empty()) continue;
+        bool repeated = false;
+        for (int j = 0; j < i && !repeated; ++j)
+            repeated = lowercase(keywords[j]) == lowercase(keywords[i]);
+        if (!repeated) addTerm(keywords[i], delta);
+    }
+}
+
+void PrefixCompleter::onInsert(int, const string &title, const string &, const string keywords[10]) {
+    feed(title, keywords, +1);
+}
+
+void PrefixCompleter::onRemove(int, const string &title, const string &, const string keywords[10]) {
+    feed(title, keywords, -1);
+}
+
+void PrefixCompleter::onClear() {
+    nodes.clear();
+    terms.clear();
+    frequency.clear();
+    termIDs.clear();
+    newNode('\0');
+}
+
+// ---------------- lookups ----------------
+vector<Completion> PrefixCompleter::complete(const string &prefix, int limit) {
+    vector<Completion> result;
+    int node = findNode(lowercase(prefix));
+    if (node == -1) return result;
+    if (nodes[node].dirty) rebuild(node);
+
+    const TrieNode &n = nodes[node];
+    for (int i = 0; i < n.topCount && (int)result.size() < limit; ++i) {
+        int t = n.top[i];
+        if (frequency[t] <= 0) continue;
+        Completion c = { terms[t], frequency[t] };
+        result.push_back(c);
+    }
+    return result;
+}
+
+vector<Completion> PrefixCompleter::suggest(const string &text, int limit) {
+    string folded = lowercase(cleanTerm(text));
+    size_t matched = 0;
+    int node = 0;
+    while (matched < folded.size()) {
+        int next = findChild(node, folded[matched]);
+        if (next == -1) break;
+        node = next;
+        matched++;
+    }
+    if (matched == 0) return vector<Completion>();
+    return complete(folded.substr(0, matched), limit);
+}
+
+// ---------------- interactive helper ----------------
+string offerCompletions(PrefixCompleter *completer, const string &typed) {
+    if (!completer || cleanTerm(typed).empty()) return typed;
+
+    auto start = high_resolution_clock::now();
+    vector<Completion> options = completer->complete(cleanTerm(typed));
+    if (options.empty()) options = completer->suggest(typed);
+    auto end = high_resolution_clock::now();
+
+    if (options.empty()) return typed;
+    for (size_t i = 0; i < options.size(); ++i)
+        if (lowercase(options[i].text) == lowercase(cleanTerm(typed))) return typed;
+
+    cout << "Suggestions:\n";
+    for (size_t i = 0; i < options.size(); ++i)
+        cout << "  " << i + 1 << ". " << options[i].text << " (" << options[i].frequency << ")\n";
+    cout << "[Performance] autocomplete lookup: "
+         << duration_cast<nanoseconds>(end - start).count() << " nanoseconds\n";
+    cout << "Pick a number, or press Enter to keep \"" << typed << "\": ";
+
+    string line;
+    getline(cin, line);
+    int pick = atoi(line.c_str());
+    if (pick >= 1 && pick <= (int)options.size()) return options[pick - 1].text;
+    return typed;
+}
@@ -0,0 +1,74 @@
+#ifndef AUTOCOMPLETE_H
+#define AUTOCOMPLETE_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "record_listener.h"
+using namespace std;
+
+struct Completion {
+    string text;      // display form (first spelling seen)
+    int frequency;    // number of records containing it
+};
+
+// Prefix completer over skills or job titles, ranked by document frequency.
+// Terms live in a first-child/next-sibling trie stored in one vector; every
+// node caches the IDs of the best TOP_K terms below it, so a lookup costs
+// O(prefix length) and never walks the subtree. Attach it to containers with
+// addListener() and it updates as records are added or deleted.
+class PrefixCompleter : public RecordListener {
+public:
+    enum Source { SKILLS, TITLES };
+    static const int TOP_K = 8;
+
+private:
+    struct TrieNode {
+        char ch;
+        int firstChild;
+        int nextSibling;
+        int termID;           // term ending here, -1 if none
+        bool dirty;           // top list needs a rebuild (after a removal)
+        int topCount;
+        int top[TOP_K];       // term IDs, best first
+    };
+
+    Source source;
+    vector<TrieNode> nodes;                  // nodes[0] is the root
+    vector<string> terms;                    // term ID -> display form
+    vector<int> frequency;                   // term ID -> record count
+    unordered_map<string, int> termIDs;      // folded term -> term ID
+
+    int newNode(char ch);
+    int findChild(int node, char ch) const;
+    int findOrAddChild(int node, char ch);
+    int findNode(const string &folded) const;
+    bool ranksBefore(int a, int b) const;
+    void promote(TrieNode &node, int termID);
+    void rebuild(int node);
+    void addTerm(const string &term, int delta);
+    void feed(const string &title, const string keywords[10], int delta);
+
+public:
+    explicit PrefixCompleter(Source source);
+
+    void onInsert(int id, const string &title, const string &description, const string keywords[10]);
+    void onRemove(int id, const string &title, const string &description, const string keywords[10]);
+    void onClear();
+    bool sharedBetweenStores() const { return true; }   // skills come from jobs and resumes
+
+    // Up to limit completions of prefix (case-insensitive), most frequent first
+    vector<Completion> complete(const string &prefix, int limit = TOP_K);
+
+    // Completions for the longest prefix of text that is known; used to
+    // suggest alternatives when a typed term matches nothing
+    vector<Completion> suggest(const string &text, int limit = TOP_K);
+
+    int termCount() const { return (int)terms.size(); }
+};
+
+// Lists completions for typed and lets the user pick one by number;
+// returns typed unchanged if it is already known or nothing is picked.
+string offerCompletions(PrefixCompleter *completer, const string &typed);
+
+#endif
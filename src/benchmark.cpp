@@ -0,0 +1,152 @@
+#include "benchmark.h"
+#include "matching.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+using namespace std;
+
+static const int MATCH_JOBS = 3;          // jobs matched against every resume
+static const int DELETES = 200;           // middle deletes on the resume store
+static const char *SEARCH_KEYWORDS[] = {
+    "Python", "SQL", "Excel", "Java", "Tableau", "Power BI", "Machine Learning",
+    "Agile", "Docker", "Cloud", "Pandas", "Git", "NLP", "Keras", "Reporting"
+};
+static const int SEARCH_COUNT = sizeof(SEARCH_KEYWORDS) / sizeof(SEARCH_KEYWORDS[0]);
+
+// ---------------- one backend ----------------
+static void addStoreMemory(const string &store, int records, vector<StoreMemory> &memory) {
+    vector<MemoryAccounting::Usage> rows = MemoryAccounting::snapshot();
+    for (size_t r = 0; r < rows.size(); ++r) {
+        if (rows[r].store != store) continue;
+        StoreMemory entry = { rows[r], records };
+        memory.push_back(entry);
+    }
+}
+
+template <class JobStore, class ResumeStore>
+static void benchmarkBackend(const string &jobFile, const string &resumeFile, vector<PerfResult> &results,
+                             vector<StoreMemory> &memory) {
+    const char *backend = ResumeStore::backendName();
+    JobStore jobs;
+    ResumeStore resumes;
+
+    {
+        PerfProbe probe("load", backend, 2, &results);
+        jobs.loadFromCSV(jobFile);
+        resumes.loadFromCSV(resumeFile);
+    }
+    addStoreMemory(string("Job ") + backend, jobs.size(), memory);
+    addStoreMemory(string("Resume ") + backend, resumes.size(), memory);
+
+    // Same work as menu option 1: score every resume, collect the results
+    typename MatchResultsFor<ResumeStore>::type *matches = nullptr;
+    {
+        PerfProbe probe("match", backend, MATCH_JOBS, &results);
+        for (int jobID = 1; jobID <= MATCH_JOBS; ++jobID) {
+            const typename JobStore::record_type *job = jobs.findByID(jobID);
+            if (!job) continue;
+            delete matches;
+            matches = new typename MatchResultsFor<ResumeStore>::type(resumes.size());
+            QuerySkills skills(job->keywords);
+            for (typename ResumeStore::const_iterator r = resumes.begin(); r != resumes.end(); ++r)
+                matches->append(r->resumeID, Matcher::keywordMatchRate(skills, r->keywords), &r->description);
+        }
+    }
+
+    if (matches) {
+        PerfProbe probe("sort", backend, 1, &results);
+        matches->sortDescending();
+    }
+    delete matches;
+
+    long long found = 0;
+    {
+        PerfProbe probe("search", backend, SEARCH_COUNT, &results);
+        for (int k = 0; k < SEARCH_COUNT; ++k) {
+            string query[10];
+            query[0] = SEARCH_KEYWORDS[k];
+            for (typename ResumeStore::const_iterator r = resumes.begin(); r != resumes.end(); ++r)
+                found += Matcher::keywordMatchCount(query, r->keywords);
+        }
+    }
+    cout << "(search matched " << found << " resume keywords)\n";
+
+    {
+        PerfProbe probe("delete", backend, DELETES, &results);
+        for (int i = 0; i < DELETES; ++i)
+            resumes.removeAt(resumes.size() / 2 + 1);
+    }
+}
+
+// ---------------- JSON ----------------
+static string jsonString(const string &s) {
+    string out = "\"";
+    for (size_t i = 0; i < s.size(); ++i) {
+        if (s[i] == '"' || s[i] == '\\') out += '\\';
+        out += s[i];
+    }
+    return out + "\"";
+}
+
+static string jsonNumber(double v) {
+    if (v < 0) return "null";
+    ostringstream ss;
+    ss << v;
+    return ss.str();
+}
+
+bool writeBenchmarkJSON(const string &filename, const vector<PerfResult> &results,
+                        const vector<StoreMemory> &memory) {
+    ofstream out(filename);
+    if (!out.is_open()) return false;
+
+    out << "{\n  \"counters_note\": " << jsonString(PerfProbe::unavailableReason()) << ",\n";
+    out << "  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const PerfResult &r = results[i];
+        out << "    {\"operation\": " << jsonString(r.operation)
+            << ", \"backend\": " << jsonString(r.backend)
+            << ", \"iterations\": " << r.iterations
+            << ", \"wall_us\": " << (long long)r.wallMicros
+            << ", \"counters_available\": " << (r.countersAvailable ? "true" : "false");
+        for (int c = 0; c < PerfProbe::COUNTER_COUNT; ++c)
+            out << ", \"" << PerfProbe::counterName(c) << "\": "
+                << (r.counters[c] >= 0 ? to_string(r.counters[c]) : string("null"));
+        out << ", \"ipc\": " << jsonNumber(perfIPC(r))
+            << ", \"cache_miss_rate\": " << jsonNumber(perfCacheMissRate(r))
+            << ", \"branch_miss_rate\": " << jsonNumber(perfBranchMissRate(r))
+            << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ],\n  \"memory\": [\n";
+    for (size_t i = 0; i < memory.size(); ++i) {
+        const StoreMemory &m = memory[i];
+        out << "    {\"store\": " << jsonString(m.usage.store) << ", \"records\": " << m.records;
+        for (int k = 0; k < MemoryAccounting::KIND_COUNT; ++k)
+            out << ", \"" << MemoryAccounting::kindName(k) << "_bytes\": " << m.usage.bytes[k];
+        out << ", \"total_bytes\": " << m.usage.total
+            << ", \"bytes_per_record\": " << (m.records > 0 ? m.usage.total / m.records : 0)
+            << "}" << (i + 1 < memory.size() ? "," : "") << "\n";
+    }
+    out << "  ],\n  \"heap_peak_bytes\": " << MemoryAccounting::peakHeapBytes()
+        << ",\n  \"rss_kb\": " << MemoryAccounting::residentKB()
+        << ",\n  \"peak_rss_kb\": " << MemoryAccounting::peakResidentKB() << "\n}\n";
+    return true;
+}
+
+int runBenchmark(const string &jobFile, const string &resumeFile, const string &outputFile) {
+    cout << "========================================\n";
+    cout << "              Benchmark                 \n";
+    cout << "========================================\n";
+
+    vector<PerfResult> results;
+    vector<StoreMemory> memory;
+    benchmarkBackend<JobLinkedList, ResumeLinkedList>(jobFile, resumeFile, results, memory);
+    benchmarkBackend<JobArray, ResumeArray>(jobFile, resumeFile, results, memory);
+
+    if (!writeBenchmarkJSON(outputFile, results, memory)) {
+        cout << "Failed to write " << outputFile << "\n";
+        return 1;
+    }
+    cout << "Benchmark results written to " << outputFile << "\n";
+    return 0;
+}
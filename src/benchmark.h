@@ -0,0 +1,25 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <string>
+#include <vector>
+#include "perf_probe.h"
+#include "memory_accounting.h"
+using namespace std;
+
+// Non-interactive benchmark (run with: main --benchmark [output.json]).
+// Loads both backends without any indexes attached and measures load,
+// match, sort, search and delete under a PerfProbe each, then writes every
+// result, hardware counters included, to a JSON file together with the
+// exact heap bytes each store holds right after loading.
+int runBenchmark(const string &jobFile, const string &resumeFile, const string &outputFile);
+
+struct StoreMemory {
+    MemoryAccounting::Usage usage;
+    int records;
+};
+
+bool writeBenchmarkJSON(const string &filename, const vector<PerfResult> &results,
+                        const vector<StoreMemory> &memory);
+
+#endif
@@ -0,0 +1,332 @@
+#include "boolean_query.h"
+#include <algorithm>
+#include <cctype>
+using namespace std;
+
+QueryNode::~QueryNode() {
+    for (size_t i = 0; i < children.size(); ++i) delete children[i];
+}
+
+// ---------------- tokenizer ----------------
+namespace {
+
+struct Token {
+    enum Kind { WORD, QUOTED, LPAREN, RPAREN, AND, OR, NOT, END };
+    Kind kind;
+    string text;
+};
+
+string upperCopy(const string &s) {
+    string r = s;
+    transform(r.begin(), r.end(), r.begin(), ::toupper);
+    return r;
+}
+
+vector<Token> tokenize(const string &text) {
+    vector<Token> tokens;
+    size_t i = 0;
+    while (i < text.size()) {
+        char c = text[i];
+        if (isspace((unsigned char)c)) { ++i; continue; }
+
+        Token t;
+        if (c == '(' || c == ')') {
+            t.kind = (c == '(') ? Token::LPAREN : Token::RPAREN;
+            ++i;
+        } else if (c == '"') {
+            size_t close = text.find('"', i + 1);
+            if (close == string::npos)
+                throw invalid_argument("unterminated quote");
+            t.kind = Token::QUOTED;
+            t.text = text.substr(i + 1, close - i - 1);
+            i = close + 1;
+        } else {
+            size_t start = i;
+            while (i < text.size() && !isspace((unsigned char)text[i]) &&
+                   text[i] != '(' && text[i] != ')' && text[i] != '"')
+                ++i;
+            t.text = text.substr(start, i - start);
+            string op = upperCopy(t.text);
+            if (op == "AND") t.kind = Token::AND;
+            else if (op == "OR") t.kind = Token::OR;
+            else if (op == "NOT") t.kind = Token::NOT;
+            else t.kind = Token::WORD;
+        }
+        tokens.push_back(t);
+    }
+    Token end;
+    end.kind = Token::END;
+    tokens.push_back(end);
+    return tokens;
+}
+
+// ---------------- recursive-descent parser ----------------
+class Parser {
+private:
+    const vector<Token> &tokens;
+    size_t pos;
+
+    const Token& peek() const { return tokens[pos]; }
+
+    // Merge a child into parent, flattening nested nodes of the same type
+    static void adopt(QueryNode *parent, QueryNode *child) {
+        if (child->type == parent->type) {
+            parent->children.insert(parent->children.end(), child->children.begin(), child->children.end());
+            child->children.clear();
+            delete child;
+        } else {
+            parent->children.push_back(child);
+        }
+    }
+
+    QueryNode* parseBinary(QueryNode::Type type, Token::Kind op) {
+        QueryNode *left = (type == QueryNode::OR) ? parseBinary(QueryNode::AND, Token::AND) : parseUnary();
+        if (peek().kind != op) return left;
+
+        QueryNode *node = new QueryNode(type);
+        adopt(node, left);
+        while (peek().kind == op) {
+            ++pos;
+            try {
+                QueryNode *right = (type == QueryNode::OR) ? parseBinary(QueryNode::AND, Token::AND) : parseUnary();
+                adopt(node, right);
+            } catch (...) {
+                delete node;
+                throw;
+            }
+        }
+        return node;
+    }
+
+    QueryNode* parseUnary() {
+        const Token &t = peek();
+        if (t.kind == Token::NOT) {
+            ++pos;
+            QueryNode *operand = parseUnary();
+            QueryNode *node = new QueryNode(QueryNode::NOT);
+            node->children.push_back(operand);
+            return node;
+        }
+        if (t.kind == Token::LPAREN) {
+            ++pos;
+            QueryNode *inner = parseExpression();
+            if (peek().kind != Token::RPAREN) {
+                delete inner;
+                throw invalid_argument("missing ')'");
+            }
+            ++pos;
+            return inner;
+        }
+        if (t.kind == Token::QUOTED) {
+            ++pos;
+            QueryNode *node = new QueryNode(QueryNode::TERM);
+            node->term = t.text;
+            return node;
+        }
+        if (t.kind == Token::WORD) {
+            QueryNode *node = new QueryNode(QueryNode::TERM);
+            node->term = t.text;
+            ++pos;
+            while (peek().kind == Token::WORD) {
+                node->term += " " + peek().text;
+                ++pos;
+            }
+            return node;
+        }
+        if (t.kind == Token::END) throw invalid_argument("query ended where a skill was expected");
+        string what = (t.kind == Token::RPAREN) ? ")" : t.text;
+        throw invalid_argument("unexpected '" + what + "'");
+    }
+
+public:
+    explicit Parser(const vector<Token> &t) : tokens(t), pos(0) {}
+
+    QueryNode* parseExpression() { return parseBinary(QueryNode::OR, Token::OR); }
+
+    QueryNode* parseQuery() {
+        QueryNode *root = parseExpression();
+        if (peek().kind != Token::END) {
+            delete root;
+            throw invalid_argument("unexpected text after end of query");
+        }
+        return root;
+    }
+};
+
+// ---------------- executor ----------------
+// Works directly on the index's compressed posting sets; only execute()
+// expands the final answer into a plain ID list.
+typedef CompressedPostings Postings;
+
+size_t evaluate(const QueryNode *node, const SkillIndex &index, Postings *out);
+
+// Cardinality estimate used to order operands (exact for terms)
+size_t estimate(const QueryNode *node, const SkillIndex &index) {
+    size_t universe = index.getAllRecords().cardinality();
+    switch (node->type) {
+        case QueryNode::TERM:
+            return index.getPostings(index.lookup(node->term)).cardinality();
+        case QueryNode::NOT:
+            return universe - min(universe, estimate(node->children[0], index));
+        case QueryNode::OR: {
+            size_t sum = 0;
+            for (size_t i = 0; i < node->children.size(); ++i)
+                sum += estimate(node->children[i], index);
+            return min(sum, universe);
+        }
+        case QueryNode::AND: {
+            size_t best = universe;
+            for (size_t i = 0; i < node->children.size(); ++i)
+                if (node->children[i]->type != QueryNode::NOT)
+                    best = min(best, estimate(node->children[i], index));
+            return best;
+        }
+    }
+    return universe;
+}
+
+// Terms are used in place; anything else is evaluated into buffer
+const Postings* materialize(const QueryNode *node, const SkillIndex &index, Postings &buffer) {
+    if (node->type == QueryNode::TERM)
+        return &index.getPostings(index.lookup(node->term));
+    evaluate(node, index, &buffer);
+    return &buffer;
+}
+
+struct ByEstimate {
+    const SkillIndex *index;
+    bool operator()(const QueryNode *a, const QueryNode *b) const {
+        return estimate(a, *index) < estimate(b, *index);
+    }
+};
+
+size_t finish(const Postings *result, Postings *out) {
+    if (out && out != result) *out = *result;
+    return result->cardinality();
+}
+
+size_t evaluateAnd(const QueryNode *node, const SkillIndex &index, Postings *out) {
+    vector<const QueryNode*> include, exclude;
+    for (size_t i = 0; i < node->children.size(); ++i) {
+        const QueryNode *c = node->children[i];
+        if (c->type == QueryNode::NOT) exclude.push_back(c->children[0]);
+        else include.push_back(c);
+    }
+
+    // Smallest positive operand first; the largest exclusion first
+    ByEstimate order = { &index };
+    sort(include.begin(), include.end(), order);
+    sort(exclude.rbegin(), exclude.rend(), order);
+
+    Postings acc, next, operandBuffer;
+    const Postings *current;
+    size_t first = 0;
+    if (include.empty()) {
+        current = &index.getAllRecords();
+    } else {
+        current = materialize(include[0], index, acc);
+        first = 1;
+    }
+
+    size_t steps = (include.size() - first) + exclude.size();
+    for (size_t s = 0; s < steps; ++s) {
+        if (current->empty()) break;
+
+        bool intersect = (first + s < include.size());
+        const QueryNode *child = intersect ? include[first + s] : exclude[first + s - include.size()];
+        const Postings *operand = materialize(child, index, operandBuffer);
+
+        if (!out && s + 1 == steps)
+            return intersect ? Postings::intersectCount(*current, *operand)
+                             : Postings::differenceCount(*current, *operand);
+
+        if (intersect) Postings::intersect(*current, *operand, next);
+        else Postings::difference(*current, *operand, next);
+        swap(acc, next);
+        current = &acc;
+    }
+    return finish(current, out);
+}
+
+size_t evaluateOr(const QueryNode *node, const SkillIndex &index, Postings *out) {
+    vector<const QueryNode*> parts(node->children.begin(), node->children.end());
+    ByEstimate order = { &index };
+    sort(parts.begin(), parts.end(), order);
+
+    Postings acc, next, operandBuffer;
+    const Postings *current = materialize(parts[0], index, acc);
+    for (size_t i = 1; i < parts.size(); ++i) {
+        const Postings *operand = materialize(parts[i], index, operandBuffer);
+        if (!out && i + 1 == parts.size())
+            return Postings::unionCount(*current, *operand);
+        Postings::unite(*current, *operand, next);
+        swap(acc, next);
+        current = &acc;
+    }
+    return finish(current, out);
+}
+
+size_t evaluate(const QueryNode *node, const SkillIndex &index, Postings *out) {
+    switch (node->type) {
+        case QueryNode::TERM:
+            return finish(&index.getPostings(index.lookup(node->term)), out);
+        case QueryNode::AND:
+            return evaluateAnd(node, index, out);
+        case QueryNode::OR:
+            return evaluateOr(node, index, out);
+        case QueryNode::NOT: {
+            const Postings &all = index.getAllRecords();
+            if (!out) return all.cardinality() - evaluate(node->children[0], index, nullptr);
+            Postings buffer;
+            const Postings *excluded = materialize(node->children[0], index, buffer);
+            Postings::difference(all, *excluded, *out);
+            return out->cardinality();
+        }
+    }
+    return 0;
+}
+
+string render(const QueryNode *node) {
+    switch (node->type) {
+        case QueryNode::TERM: return node->term;
+        case QueryNode::NOT:  return "NOT " + render(node->children[0]);
+        default: {
+            string sep = (node->type == QueryNode::AND) ? " AND " : " OR ";
+            string s = "(";
+            for (size_t i = 0; i < node->children.size(); ++i) {
+                if (i) s += sep;
+                s += render(node->children[i]);
+            }
+            return s + ")";
+        }
+    }
+}
+
+} // namespace
+
+// ---------------- BooleanQuery ----------------
+BooleanQuery::BooleanQuery(const string &text) : root(nullptr) {
+    vector<Token> tokens = tokenize(text);
+    Parser parser(tokens);
+    root = parser.parseQuery();
+}
+
+BooleanQuery::~BooleanQuery() {
+    delete root;
+}
+
+PostingList BooleanQuery::execute(const SkillIndex &index) const {
+    CompressedPostings matches;
+    evaluate(root, index, &matches);
+    PostingList result;
+    matches.toList(result);
+    return result;
+}
+
+size_t BooleanQuery::count(const SkillIndex &index) const {
+    return evaluate(root, index, nullptr);
+}
+
+string BooleanQuery::toString() const {
+    return render(root);
+}
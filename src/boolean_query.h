@@ -0,0 +1,48 @@
+#ifndef BOOLEAN_QUERY_H
+#define BOOLEAN_QUERY_H
+
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include "skill_index.h"
+using namespace std;
+
+// Parsed form of a query such as  Python AND (PyTorch OR TensorFlow) AND NOT Java
+//   expr    := andExpr { OR andExpr }
+//   andExpr := unary { AND unary }
+//   unary   := NOT unary | '(' expr ')' | term
+//   term    := word { word } | "quoted text"
+// Operators are case-insensitive; a term may span several words ("Power BI").
+struct QueryNode {
+    enum Type { TERM, AND, OR, NOT };
+    Type type;
+    string term;                   // TERM only
+    vector<QueryNode*> children;
+
+    explicit QueryNode(Type t) : type(t) {}
+    ~QueryNode();
+};
+
+class BooleanQuery {
+private:
+    QueryNode *root;
+
+    BooleanQuery(const BooleanQuery &);             // not copyable
+    BooleanQuery& operator=(const BooleanQuery &);
+
+public:
+    // Throws invalid_argument with a readable message on syntax errors
+    explicit BooleanQuery(const string &text);
+    ~BooleanQuery();
+
+    // Sorted IDs of every record satisfying the query
+    PostingList execute(const SkillIndex &index) const;
+
+    // Number of matching records; the final intersection/union is counted
+    // without writing out a result list
+    size_t count(const SkillIndex &index) const;
+
+    string toString() const;       // normalized, fully parenthesized form
+};
+
+#endif
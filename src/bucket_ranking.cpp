@@ -0,0 +1,60 @@
+#include "bucket_ranking.h"
+#include <cmath>
+using namespace std;
+
+BucketRanking::BucketRanking(int count) : keywordCount(count) {
+    for (int s = 0; s <= MAX_SCORE + 1; ++s) bucketStart[s] = 0;
+}
+
+void BucketRanking::add(int id, int matched, const PackedText *desc) {
+    if (matched < 0) matched = 0;
+    if (matched > MAX_SCORE) matched = MAX_SCORE;
+    RankedEntry e = { id, matched, desc };
+    pending.push_back(e);
+}
+
+void BucketRanking::finalize() {
+    // Count per score, then lay buckets out from the highest score down
+    int counts[MAX_SCORE + 1] = { 0 };
+    for (size_t i = 0; i < pending.size(); ++i) counts[pending[i].matched]++;
+
+    int next[MAX_SCORE + 1];
+    int offset = 0;
+    bucketStart[MAX_SCORE + 1] = 0;
+    for (int s = MAX_SCORE; s >= 0; --s) {
+        next[s] = offset;
+        offset += counts[s];
+        bucketStart[s] = offset;          // records with matched >= s end here
+    }
+
+    ranked.resize(pending.size());
+    for (size_t i = 0; i < pending.size(); ++i)
+        ranked[next[pending[i].matched]++] = pending[i];
+    EntryList().swap(pending);
+}
+
+int BucketRanking::minMatchedFor(double minRate) const {
+    if (keywordCount == 0 || minRate <= 0) return 0;
+    int m = (int)ceil(minRate * keywordCount / 100.0 - 1e-9);
+    return m > MAX_SCORE ? MAX_SCORE + 1 : m;
+}
+
+int BucketRanking::countAtLeast(int minMatched) const {
+    if (minMatched <= 0) return (int)ranked.size();
+    if (minMatched > MAX_SCORE) return 0;
+    return bucketStart[minMatched];
+}
+
+int BucketRanking::bucketSize(int matched) const {
+    if (matched < 0 || matched > MAX_SCORE) return 0;
+    return countAtLeast(matched) - countAtLeast(matched + 1);
+}
+
+void BucketRanking::page(int pageNumber, int pageSize, int minMatched, vector<RankedEntry> &out) const {
+    out.clear();
+    if (pageNumber < 1 || pageSize < 1) return;
+    int total = countAtLeast(minMatched);
+    long long first = (long long)(pageNumber - 1) * pageSize;
+    for (long long i = first; i < total && i < first + pageSize; ++i)
+        out.push_back(ranked[(size_t)i]);
+}
@@ -0,0 +1,55 @@
+#ifndef BUCKET_RANKING_H
+#define BUCKET_RANKING_H
+
+#include <string>
+#include <vector>
+#include "text_codec.h"
+#include "query_arena.h"
+using namespace std;
+
+struct RankedEntry {
+    int id;
+    int matched;              // job keywords found in the record
+    const PackedText *desc;   // points into the container, not copied
+};
+
+// Full ranking of match results without a comparison sort.
+// A match score is matched / keywordCount with keywordCount <= 10, so there
+// are at most 11 distinct scores. Results are grouped into one bucket per
+// matched count with a counting sort (O(N)), best bucket first, records in
+// insertion order inside a bucket. Any page of the ranking is then a direct
+// offset into that order.
+class BucketRanking {
+public:
+    static const int MAX_SCORE = 10;
+
+private:
+    int keywordCount;
+    // Scratch for one query: from the query arena inside a QueryScope
+    typedef vector<RankedEntry, ArenaAllocator<RankedEntry> > EntryList;
+    EntryList pending;                // add() order
+    EntryList ranked;                 // after finalize(): best score first
+    int bucketStart[MAX_SCORE + 2];   // first ranked index with matched <= s
+
+public:
+    explicit BucketRanking(int keywordCount);
+
+    void reserve(size_t n) { pending.reserve(n); }
+    void add(int id, int matched, const PackedText *desc);
+    void finalize();                  // counting sort, call once after adding
+
+    int getKeywordCount() const { return keywordCount; }
+    double rateOf(int matched) const { return keywordCount ? matched * 100.0 / keywordCount : 0.0; }
+
+    // Smallest matched count whose rate is at least minRate percent
+    int minMatchedFor(double minRate) const;
+
+    // Results with at least minMatched keywords (they form a prefix of the ranking)
+    int countAtLeast(int minMatched) const;
+    int bucketSize(int matched) const;
+
+    // 1-based page of the results with at least minMatched keywords
+    void page(int pageNumber, int pageSize, int minMatched, vector<RankedEntry> &out) const;
+};
+
+#endif
@@ -0,0 +1,26 @@
+#include "bulk_import.h"
+#include "metrics.h"
+#include <iostream>
+using namespace std;
+
+void readImportLines(istream &in, const string &header, vector<string> &lines) {
+    TRACE_SCOPE("readImportLines");
+    string line;
+    bool first = true;
+    while (tracedGetline(in, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();   // CRLF files
+        if (first) {
+            first = false;
+            if (line == header) continue;
+        }
+        if (!line.empty()) lines.push_back(line);
+    }
+}
+
+void reportBulkImport(const string &store, const char *backend, int records, long long micros) {
+    double perSecond = micros > 0 ? records * 1000000.0 / micros : 0.0;
+    cout << "Imported " << records << " records into " << store << "\n";
+    cout << "[Performance] bulkImport [" << store << "] execution time: " << micros
+         << " microseconds (" << (long long)perSecond << " records/sec)\n";
+    recordLatency("bulk_import", backend, micros);
+}
@@ -0,0 +1,23 @@
+#ifndef BULK_IMPORT_H
+#define BULK_IMPORT_H
+
+#include <string>
+#include <vector>
+#include <istream>
+#include "parallel.h"
+using namespace std;
+
+// Shared plumbing for the containers' bulkImport(). A bulk import reads a
+// whole file or stream of new records, grows the store once, extracts the
+// keywords of the batch on several threads, tells the indexes about it in
+// one pass and saves the CSV once at the end, instead of paying every one
+// of those costs per record the way addRecord() does.
+
+// Every non-empty line of in; the first line is dropped when it is the CSV
+// header (e.g. "resume"), so both exported CSVs and plain text files work
+void readImportLines(istream &in, const string &header, vector<string> &lines);
+
+// Print the "[Performance] bulkImport" line with records/sec and record the latency
+void reportBulkImport(const string &store, const char *backend, int records, long long micros);
+
+#endif
@@ -0,0 +1,567 @@
+#include "compressed_postings.h"
+#include <algorithm>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+using namespace std;
+
+typedef CompressedPostings::Container Container;
+
+static const int ARRAY_MAX = 4096;        // above this a bitmap is smaller
+static const int BITMAP_WORDS = 1024;     // 65536 bits
+static const size_t GALLOP_RATIO = 16;
+
+static inline int popcount64(uint64_t x) {
+#ifdef _MSC_VER
+    return (int)__popcnt64(x);
+#else
+    return __builtin_popcountll(x);
+#endif
+}
+
+static inline int ctz64(uint64_t x) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, x);
+    return (int)index;
+#else
+    return __builtin_ctzll(x);
+#endif
+}
+
+// ---------------- container helpers ----------------
+template <class F>
+static void forEachValue(const Container &c, F f) {
+    if (c.type == CompressedPostings::ARRAY) {
+        for (size_t i = 0; i < c.values.size(); ++i) f(c.values[i]);
+    } else if (c.type == CompressedPostings::BITMAP) {
+        for (int w = 0; w < BITMAP_WORDS; ++w) {
+            uint64_t word = c.bits[w];
+            while (word) {
+                int bit = ctz64(word);
+                f((uint16_t)(w * 64 + bit));
+                word &= word - 1;
+            }
+        }
+    } else {
+        for (size_t r = 0; r < c.values.size(); r += 2)
+            for (int v = c.values[r]; v <= c.values[r] + c.values[r + 1]; ++v) f((uint16_t)v);
+    }
+}
+
+static void setRange(vector<uint64_t> &words, int first, int last, bool value) {
+    int fw = first >> 6, lw = last >> 6;
+    uint64_t firstMask = ~0ULL << (first & 63);
+    uint64_t lastMask = ~0ULL >> (63 - (last & 63));
+    if (fw == lw) {
+        if (value) words[fw] |= firstMask & lastMask;
+        else words[fw] &= ~(firstMask & lastMask);
+        return;
+    }
+    if (value) {
+        words[fw] |= firstMask;
+        for (int w = fw + 1; w < lw; ++w) words[w] = ~0ULL;
+        words[lw] |= lastMask;
+    } else {
+        words[fw] &= ~firstMask;
+        for (int w = fw + 1; w < lw; ++w) words[w] = 0;
+        words[lw] &= ~lastMask;
+    }
+}
+
+// Apply a container's values to a bitmap (set or clear)
+static void applyToBitmap(const Container &c, vector<uint64_t> &words, bool value) {
+    if (c.type == CompressedPostings::BITMAP) {
+        for (int w = 0; w < BITMAP_WORDS; ++w)
+            words[w] = value ? (words[w] | c.bits[w]) : (words[w] & ~c.bits[w]);
+    } else if (c.type == CompressedPostings::RUN) {
+        for (size_t r = 0; r < c.values.size(); r += 2)
+            setRange(words, c.values[r], c.values[r] + c.values[r + 1], value);
+    } else {
+        for (size_t i = 0; i < c.values.size(); ++i) {
+            uint64_t bit = 1ULL << (c.values[i] & 63);
+            if (value) words[c.values[i] >> 6] |= bit;
+            else words[c.values[i] >> 6] &= ~bit;
+        }
+    }
+}
+
+static void toBitmap(const Container &c, vector<uint64_t> &words) {
+    if (c.type == CompressedPostings::BITMAP) {
+        words = c.bits;
+        return;
+    }
+    words.assign(BITMAP_WORDS, 0);
+    applyToBitmap(c, words, true);
+}
+
+// Turn a bitmap into an ARRAY or BITMAP container (whichever is smaller)
+static void fromBitmap(Container &c, uint16_t key, vector<uint64_t> &words) {
+    int card = 0;
+    for (int w = 0; w < BITMAP_WORDS; ++w) card += popcount64(words[w]);
+
+    c.key = key;
+    c.cardinality = card;
+    c.values.clear();
+    c.bits.clear();
+    if (card > ARRAY_MAX) {
+        c.type = CompressedPostings::BITMAP;
+        c.bits.swap(words);
+        return;
+    }
+    c.type = CompressedPostings::ARRAY;
+    c.values.reserve(card);
+    for (int w = 0; w < BITMAP_WORDS; ++w) {
+        uint64_t word = words[w];
+        while (word) {
+            c.values.push_back((uint16_t)(w * 64 + ctz64(word)));
+            word &= word - 1;
+        }
+    }
+}
+
+// Index of the RUN pair holding low (-1 if no run covers it)
+static int findRun(const Container &c, uint16_t low) {
+    // last run starting at or before low
+    int lo = 0, hi = (int)c.values.size() / 2 - 1, found = -1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        if (c.values[2 * mid] <= low) { found = mid; lo = mid + 1; }
+        else hi = mid - 1;
+    }
+    if (found >= 0 && low <= c.values[2 * found] + c.values[2 * found + 1]) return found;
+    return -1;
+}
+
+static bool containerContains(const Container &c, uint16_t low) {
+    if (c.type == CompressedPostings::ARRAY)
+        return binary_search(c.values.begin(), c.values.end(), low);
+    if (c.type == CompressedPostings::BITMAP)
+        return (c.bits[low >> 6] >> (low & 63)) & 1;
+    return findRun(c, low) >= 0;
+}
+
+// Pick the smallest of ARRAY / BITMAP / RUN for the container's contents
+static void optimizeContainer(Container &c) {
+    int runs = 0;
+    int prev = -2;
+    forEachValue(c, [&](uint16_t v) {
+        if (v != prev + 1) runs++;
+        prev = v;
+    });
+
+    size_t arrayBytes = (c.cardinality <= ARRAY_MAX) ? 2 * (size_t)c.cardinality : (size_t)-1;
+    size_t bitmapBytes = BITMAP_WORDS * 8;
+    size_t runBytes = 4 * (size_t)runs;
+
+    if (runBytes < arrayBytes && runBytes < bitmapBytes) {
+        if (c.type == CompressedPostings::RUN) return;
+        vector<uint16_t> pairs;
+        pairs.reserve(2 * runs);
+        prev = -2;
+        forEachValue(c, [&](uint16_t v) {
+            if (v != prev + 1) { pairs.push_back(v); pairs.push_back(0); }
+            else pairs.back()++;
+            prev = v;
+        });
+        c.type = CompressedPostings::RUN;
+        c.values.swap(pairs);
+        vector<uint64_t>().swap(c.bits);
+    } else if (c.type == CompressedPostings::RUN) {
+        vector<uint64_t> words;
+        toBitmap(c, words);
+        fromBitmap(c, c.key, words);
+    }
+    c.values.shrink_to_fit();
+}
+
+// First index >= lo with data[index] >= target (exponential probe, then binary search)
+static size_t gallop16(const vector<uint16_t> &data, size_t lo, uint16_t target) {
+    size_t n = data.size();
+    if (lo >= n || data[lo] >= target) return lo;
+    size_t step = 1, prev = lo, probe = lo + 1;
+    while (probe < n && data[probe] < target) {
+        prev = probe;
+        step <<= 1;
+        probe = lo + step;
+    }
+    if (probe > n) probe = n;
+    return lower_bound(data.begin() + prev + 1, data.begin() + probe, target) - data.begin();
+}
+
+// ---------------- container kernels ----------------
+// Intersection of two containers with the same key. Returns the count;
+// fills out only when it is not null.
+static int intersectContainers(const Container &x, const Container &y, Container *out) {
+    const Container &a = (x.type <= y.type) ? x : y;    // ARRAY < BITMAP < RUN
+    const Container &b = (x.type <= y.type) ? y : x;
+    int count = 0;
+    vector<uint16_t> values;
+
+    if (a.type == CompressedPostings::ARRAY && b.type == CompressedPostings::ARRAY) {
+        const vector<uint16_t> &s = (a.values.size() <= b.values.size()) ? a.values : b.values;
+        const vector<uint16_t> &l = (a.values.size() <= b.values.size()) ? b.values : a.values;
+        if (!s.empty() && l.size() / s.size() >= GALLOP_RATIO) {
+            size_t j = 0;
+            for (size_t i = 0; i < s.size() && j < l.size(); ++i) {
+                j = gallop16(l, j, s[i]);
+                if (j < l.size() && l[j] == s[i]) {
+                    count++;
+                    if (out) values.push_back(s[i]);
+                }
+            }
+        } else {
+            size_t i = 0, j = 0;
+            while (i < s.size() && j < l.size()) {
+                if (s[i] < l[j]) ++i;
+                else if (s[i] > l[j]) ++j;
+                else {
+                    count++;
+                    if (out) values.push_back(s[i]);
+                    ++i; ++j;
+                }
+            }
+        }
+    } else if (a.type == CompressedPostings::ARRAY && b.type == CompressedPostings::BITMAP) {
+        for (size_t i = 0; i < a.values.size(); ++i) {
+            uint16_t v = a.values[i];
+            if ((b.bits[v >> 6] >> (v & 63)) & 1) {
+                count++;
+                if (out) values.push_back(v);
+            }
+        }
+    } else if (a.type == CompressedPostings::ARRAY && b.type == CompressedPostings::RUN) {
+        size_t r = 0;
+        for (size_t i = 0; i < a.values.size() && r < b.values.size(); ++i) {
+            uint16_t v = a.values[i];
+            while (r < b.values.size() && b.values[r] + b.values[r + 1] < v) r += 2;
+            if (r < b.values.size() && b.values[r] <= v) {
+                count++;
+                if (out) values.push_back(v);
+            }
+        }
+    } else if (a.type == CompressedPostings::RUN && b.type == CompressedPostings::RUN) {
+        size_t i = 0, j = 0;
+        while (i < a.values.size() && j < b.values.size()) {
+            int aStart = a.values[i], aEnd = aStart + a.values[i + 1];
+            int bStart = b.values[j], bEnd = bStart + b.values[j + 1];
+            int start = max(aStart, bStart), end = min(aEnd, bEnd);
+            if (start <= end) {
+                count += end - start + 1;
+                if (out) { values.push_back((uint16_t)start); values.push_back((uint16_t)(end - start)); }
+            }
+            if (aEnd < bEnd) i += 2;
+            else j += 2;
+        }
+        if (out && count > 0) {
+            out->key = a.key;
+            out->type = CompressedPostings::RUN;
+            out->cardinality = count;
+            out->values.swap(values);
+            out->bits.clear();
+            optimizeContainer(*out);
+        }
+        return count;
+    } else {
+        // BITMAP with BITMAP or RUN: word-wise AND
+        vector<uint64_t> words;
+        toBitmap(b, words);
+        for (int w = 0; w < BITMAP_WORDS; ++w) {
+            words[w] &= a.bits[w];
+            count += popcount64(words[w]);
+        }
+        if (out && count > 0) fromBitmap(*out, a.key, words);
+        return count;
+    }
+
+    if (out && count > 0) {
+        out->key = a.key;
+        out->type = CompressedPostings::ARRAY;
+        out->cardinality = count;
+        out->values.swap(values);
+        out->bits.clear();
+    }
+    return count;
+}
+
+static void unionContainers(const Container &a, const Container &b, Container &out) {
+    if (a.type == CompressedPostings::ARRAY && b.type == CompressedPostings::ARRAY &&
+        a.cardinality + b.cardinality <= ARRAY_MAX) {
+        out.key = a.key;
+        out.type = CompressedPostings::ARRAY;
+        out.values.clear();
+        out.bits.clear();
+        set_union(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(),
+                  back_inserter(out.values));
+        out.cardinality = (int)out.values.size();
+        return;
+    }
+    vector<uint64_t> words;
+    toBitmap(a, words);
+    applyToBitmap(b, words, true);
+    fromBitmap(out, a.key, words);
+    if (a.type == CompressedPostings::RUN || b.type == CompressedPostings::RUN)
+        optimizeContainer(out);
+}
+
+// a \ b for two containers with the same key; returns the resulting count
+static int differenceContainers(const Container &a, const Container &b, Container &out) {
+    if (a.type == CompressedPostings::ARRAY) {
+        out.key = a.key;
+        out.type = CompressedPostings::ARRAY;
+        out.values.clear();
+        out.bits.clear();
+        for (size_t i = 0; i < a.values.size(); ++i)
+            if (!containerContains(b, a.values[i])) out.values.push_back(a.values[i]);
+        out.cardinality = (int)out.values.size();
+        return out.cardinality;
+    }
+    vector<uint64_t> words;
+    toBitmap(a, words);
+    applyToBitmap(b, words, false);
+    fromBitmap(out, a.key, words);
+    return out.cardinality;
+}
+
+// ---------------- CompressedPostings ----------------
+CompressedPostings::CompressedPostings(const PostingList &sortedIDs) {
+    size_t i = 0;
+    while (i < sortedIDs.size()) {
+        uint16_t key = (uint16_t)((unsigned)sortedIDs[i] >> 16);
+        size_t end = i;
+        while (end < sortedIDs.size() && (uint16_t)((unsigned)sortedIDs[end] >> 16) == key) ++end;
+
+        Container c;
+        c.key = key;
+        c.type = ARRAY;
+        c.cardinality = (int)(end - i);
+        if (c.cardinality > ARRAY_MAX) {
+            c.type = BITMAP;
+            c.bits.assign(BITMAP_WORDS, 0);
+            for (size_t k = i; k < end; ++k) {
+                uint16_t v = (uint16_t)(sortedIDs[k] & 0xFFFF);
+                c.bits[v >> 6] |= 1ULL << (v & 63);
+            }
+        } else {
+            c.values.reserve(c.cardinality);
+            for (size_t k = i; k < end; ++k) c.values.push_back((uint16_t)(sortedIDs[k] & 0xFFFF));
+        }
+        optimizeContainer(c);
+        containers.push_back(c);
+        i = end;
+    }
+}
+
+int CompressedPostings::findContainer(uint16_t key) const {
+    if (!containers.empty() && containers.back().key == key) return (int)containers.size() - 1;
+    int lo = 0, hi = (int)containers.size() - 1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        if (containers[mid].key == key) return mid;
+        if (containers[mid].key < key) lo = mid + 1;
+        else hi = mid - 1;
+    }
+    return -1;
+}
+
+void CompressedPostings::add(int id) {
+    uint16_t key = (uint16_t)((unsigned)id >> 16);
+    uint16_t low = (uint16_t)(id & 0xFFFF);
+
+    int idx = findContainer(key);
+    if (idx == -1) {
+        Container c;
+        c.key = key;
+        c.type = ARRAY;
+        c.cardinality = 1;
+        c.values.push_back(low);
+        vector<Container>::iterator pos = containers.begin();
+        while (pos != containers.end() && pos->key < key) ++pos;
+        containers.insert(pos, c);
+        return;
+    }
+
+    Container &c = containers[idx];
+    if (c.type == RUN) {
+        if (containerContains(c, low)) return;
+        uint16_t lastEnd = (uint16_t)(c.values[c.values.size() - 2] + c.values.back());
+        if (low == lastEnd + 1) {          // appending right after the last run
+            c.values.back()++;
+            c.cardinality++;
+            return;
+        }
+        vector<uint64_t> words;
+        toBitmap(c, words);
+        fromBitmap(c, key, words);
+    }
+
+    if (c.type == ARRAY) {
+        vector<uint16_t>::iterator it = lower_bound(c.values.begin(), c.values.end(), low);
+        if (it != c.values.end() && *it == low) return;
+        c.values.insert(it, low);
+        c.cardinality++;
+        if (c.cardinality > ARRAY_MAX) {
+            vector<uint64_t> words;
+            toBitmap(c, words);
+            fromBitmap(c, key, words);
+        }
+    } else {
+        uint64_t bit = 1ULL << (low & 63);
+        if (c.bits[low >> 6] & bit) return;
+        c.bits[low >> 6] |= bit;
+        c.cardinality++;
+    }
+}
+
+void CompressedPostings::remove(int id) {
+    uint16_t key = (uint16_t)((unsigned)id >> 16);
+    uint16_t low = (uint16_t)(id & 0xFFFF);
+
+    int idx = findContainer(key);
+    if (idx == -1) return;
+    Container &c = containers[idx];
+
+    if (c.type == ARRAY) {
+        vector<uint16_t>::iterator it = lower_bound(c.values.begin(), c.values.end(), low);
+        if (it == c.values.end() || *it != low) return;
+        c.values.erase(it);
+        c.cardinality--;
+    } else if (c.type == BITMAP) {
+        uint64_t bit = 1ULL << (low & 63);
+        if (!(c.bits[low >> 6] & bit)) return;
+        c.bits[low >> 6] &= ~bit;
+        c.cardinality--;
+        if (c.cardinality == ARRAY_MAX) {   // small enough for an array again
+            vector<uint64_t> words;
+            words.swap(c.bits);
+            fromBitmap(c, key, words);
+        }
+    } else {
+        // RUN: trim the run holding low, or split it in two around low
+        int r = findRun(c, low);
+        if (r < 0) return;
+        uint16_t start = c.values[2 * r];
+        uint16_t end = (uint16_t)(start + c.values[2 * r + 1]);
+        if (start == end) {
+            c.values.erase(c.values.begin() + 2 * r, c.values.begin() + 2 * r + 2);
+        } else if (low == start) {
+            c.values[2 * r]++;
+            c.values[2 * r + 1]--;
+        } else if (low == end) {
+            c.values[2 * r + 1]--;
+        } else {
+            c.values[2 * r + 1] = (uint16_t)(low - 1 - start);
+            uint16_t tail[2] = { (uint16_t)(low + 1), (uint16_t)(end - low - 1) };
+            c.values.insert(c.values.begin() + 2 * r + 2, tail, tail + 2);
+        }
+        c.cardinality--;
+    }
+    if (c.cardinality == 0) containers.erase(containers.begin() + idx);
+}
+
+bool CompressedPostings::contains(int id) const {
+    int idx = findContainer((uint16_t)((unsigned)id >> 16));
+    return idx != -1 && containerContains(containers[idx], (uint16_t)(id & 0xFFFF));
+}
+
+size_t CompressedPostings::cardinality() const {
+    size_t n = 0;
+    for (size_t i = 0; i < containers.size(); ++i) n += containers[i].cardinality;
+    return n;
+}
+
+void CompressedPostings::toList(PostingList &out) const {
+    out.resize(cardinality());
+    if (!out.empty()) toArray(&out[0]);
+}
+
+void CompressedPostings::toArray(int *out) const {
+    for (size_t i = 0; i < containers.size(); ++i) {
+        int high = (int)containers[i].key << 16;
+        forEachValue(containers[i], [&](uint16_t v) { *out++ = high | v; });
+    }
+}
+
+void CompressedPostings::optimize() {
+    for (size_t i = 0; i < containers.size(); ++i) optimizeContainer(containers[i]);
+    containers.shrink_to_fit();
+}
+
+size_t CompressedPostings::memoryBytes() const {
+    size_t bytes = sizeof(*this) + containers.capacity() * sizeof(Container);
+    for (size_t i = 0; i < containers.size(); ++i)
+        bytes += containers[i].values.capacity() * sizeof(uint16_t) +
+                 containers[i].bits.capacity() * sizeof(uint64_t);
+    return bytes;
+}
+
+void CompressedPostings::containerCounts(int counts[3]) const {
+    for (size_t i = 0; i < containers.size(); ++i) counts[containers[i].type]++;
+}
+
+// ---------------- set operations ----------------
+void CompressedPostings::intersect(const CompressedPostings &a, const CompressedPostings &b, CompressedPostings &out) {
+    out.containers.clear();
+    size_t i = 0, j = 0;
+    while (i < a.containers.size() && j < b.containers.size()) {
+        if (a.containers[i].key < b.containers[j].key) ++i;
+        else if (a.containers[i].key > b.containers[j].key) ++j;
+        else {
+            Container c;
+            if (intersectContainers(a.containers[i], b.containers[j], &c) > 0)
+                out.containers.push_back(c);
+            ++i; ++j;
+        }
+    }
+}
+
+void CompressedPostings::unite(const CompressedPostings &a, const CompressedPostings &b, CompressedPostings &out) {
+    out.containers.clear();
+    size_t i = 0, j = 0;
+    while (i < a.containers.size() || j < b.containers.size()) {
+        if (j == b.containers.size() || (i < a.containers.size() && a.containers[i].key < b.containers[j].key)) {
+            out.containers.push_back(a.containers[i++]);
+        } else if (i == a.containers.size() || a.containers[i].key > b.containers[j].key) {
+            out.containers.push_back(b.containers[j++]);
+        } else {
+            Container c;
+            unionContainers(a.containers[i], b.containers[j], c);
+            out.containers.push_back(c);
+            ++i; ++j;
+        }
+    }
+}
+
+void CompressedPostings::difference(const CompressedPostings &a, const CompressedPostings &b, CompressedPostings &out) {
+    out.containers.clear();
+    size_t j = 0;
+    for (size_t i = 0; i < a.containers.size(); ++i) {
+        while (j < b.containers.size() && b.containers[j].key < a.containers[i].key) ++j;
+        if (j == b.containers.size() || b.containers[j].key != a.containers[i].key) {
+            out.containers.push_back(a.containers[i]);
+            continue;
+        }
+        Container c;
+        if (differenceContainers(a.containers[i], b.containers[j], c) > 0)
+            out.containers.push_back(c);
+    }
+}
+
+size_t CompressedPostings::intersectCount(const CompressedPostings &a, const CompressedPostings &b) {
+    size_t n = 0;
+    size_t i = 0, j = 0;
+    while (i < a.containers.size() && j < b.containers.size()) {
+        if (a.containers[i].key < b.containers[j].key) ++i;
+        else if (a.containers[i].key > b.containers[j].key) ++j;
+        else n += intersectContainers(a.containers[i++], b.containers[j++], nullptr);
+    }
+    return n;
+}
+
+size_t CompressedPostings::unionCount(const CompressedPostings &a, const CompressedPostings &b) {
+    return a.cardinality() + b.cardinality() - intersectCount(a, b);
+}
+
+size_t CompressedPostings::differenceCount(const CompressedPostings &a, const CompressedPostings &b) {
+    return a.cardinality() - intersectCount(a, b);
+}
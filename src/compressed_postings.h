@@ -0,0 +1,67 @@
+#ifndef COMPRESSED_POSTINGS_H
+#define COMPRESSED_POSTINGS_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "posting_ops.h"
+using namespace std;
+
+// Sorted set of record IDs stored roaring-bitmap style: IDs are split into
+// chunks of 65536 by their high 16 bits, and each chunk picks the cheapest
+// of three containers for its contents:
+//   ARRAY  - sorted 16-bit values        (2 bytes per ID, up to 4096 IDs)
+//   BITMAP - 65536 bits                  (8 KB, for dense chunks)
+//   RUN    - (start, length - 1) pairs   (4 bytes per run of consecutive IDs)
+// Every container fits in 8 KB, so set operations walk cache-sized pieces.
+// Intersections, unions and differences work container by container on the
+// compressed form; nothing is expanded to a plain ID list.
+class CompressedPostings {
+public:
+    enum ContainerType { ARRAY = 0, BITMAP = 1, RUN = 2 };
+
+    struct Container {
+        uint16_t key;                 // high 16 bits shared by the chunk
+        unsigned char type;
+        int cardinality;
+        vector<uint16_t> values;      // ARRAY values or RUN pairs
+        vector<uint64_t> bits;        // BITMAP words (1024)
+    };
+
+private:
+    vector<Container> containers;     // ascending by key
+
+    int findContainer(uint16_t key) const;
+
+public:
+    CompressedPostings() {}
+    explicit CompressedPostings(const PostingList &sortedIDs);
+
+    void add(int id);
+    void remove(int id);
+    bool contains(int id) const;
+    void clear() { containers.clear(); }
+
+    size_t cardinality() const;
+    bool empty() const { return containers.empty(); }
+    void toList(PostingList &out) const;
+    void toArray(int *out) const;     // writes cardinality() IDs, ascending
+
+    // Re-pick the cheapest container for every chunk (turns long ID ranges
+    // into runs); inserts only switch between ARRAY and BITMAP on their own
+    void optimize();
+
+    size_t memoryBytes() const;
+    void containerCounts(int counts[3]) const;
+
+    // Set operations. out must not alias a or b.
+    static void intersect(const CompressedPostings &a, const CompressedPostings &b, CompressedPostings &out);
+    static void unite(const CompressedPostings &a, const CompressedPostings &b, CompressedPostings &out);
+    static void difference(const CompressedPostings &a, const CompressedPostings &b, CompressedPostings &out);
+
+    static size_t intersectCount(const CompressedPostings &a, const CompressedPostings &b);
+    static size_t unionCount(const CompressedPostings &a, const CompressedPostings &b);
+    static size_t differenceCount(const CompressedPostings &a, const CompressedPostings &b);
+};
+
+#endif
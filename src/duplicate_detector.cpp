@@ -0,0 +1,255 @@
+#include "duplicate_detector.h"
+#include "utility.h"
+#include "metrics.h"
+#include <iostream>
+#include <algorithm>
+#include <unordered_set>
+#include <chrono>
+using namespace std;
+using namespace std::chrono;
+
+// ---------------- hashing ----------------
+static uint64_t mix64(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+static uint64_t hashString(const string &s) {
+    uint64_t h = 1469598103934665603ULL;   // FNV-1a
+    for (size_t i = 0; i < s.size(); ++i) {
+        h ^= (unsigned char)s[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+static string normalizeTerm(const string &s) {
+    size_t start = s.find_first_not_of(" \"");
+    if (start == string::npos) return "";
+    size_t end = s.find_last_not_of(" \"");
+    string r = s.substr(start, end - start + 1);
+    transform(r.begin(), r.end(), r.begin(), ::tolower);
+    return r;
+}
+
+DuplicateDetector::DuplicateDetector(double skillLimit, double textLimit)
+    : skillThreshold(skillLimit), textThreshold(textLimit) {}
+
+void DuplicateDetector::minHash(const vector<uint64_t> &features, uint32_t out[HASHES]) {
+    for (int i = 0; i < HASHES; ++i) out[i] = 0xFFFFFFFFu;
+    for (size_t f = 0; f < features.size(); ++f) {
+        for (int i = 0; i < HASHES; ++i) {
+            uint32_t h = (uint32_t)mix64(features[f] ^ (0x9e3779b97f4a7c15ULL * (uint64_t)(i + 1)));
+            if (h < out[i]) out[i] = h;
+        }
+    }
+}
+
+uint64_t DuplicateDetector::bandKey(const uint32_t sig[HASHES], int band) {
+    uint64_t h = mix64((uint64_t)band + 1);
+    for (int r = 0; r < ROWS; ++r) h = mix64(h ^ sig[band * ROWS + r]);
+    return h;
+}
+
+double DuplicateDetector::similarity(const uint32_t a[HASHES], const uint32_t b[HASHES]) {
+    int same = 0;
+    for (int i = 0; i < HASHES; ++i)
+        if (a[i] == b[i]) same++;
+    return (double)same / HASHES;
+}
+
+void DuplicateDetector::buildSignature(const string &title, const string &description,
+                                       const string keywords[10], Signature &sig) const {
+    vector<uint64_t> features;
+
+    // Skill set: order-insensitive by construction
+    for (int i = 0; i < 10; ++i) {
+        string skill = normalizeTerm(keywords[i]);
+        if (!skill.empty() && !isStopWord(skill)) features.push_back(hashString("s:" + skill));
+    }
+    string t = normalizeTerm(title);
+    if (!t.empty()) features.push_back(hashString("t:" + t));
+    sig.hasSkills = !features.empty();
+    minHash(features, sig.skills);
+
+    // Description: 3-word shingles of the content words
+    vector<string> words, content;
+    tokenizeText(description, words);
+    for (size_t i = 0; i < words.size(); ++i)
+        if (!isStopWord(words[i])) content.push_back(words[i]);
+
+    features.clear();
+    if (!content.empty() && content.size() < 3) {
+        string all;
+        for (size_t i = 0; i < content.size(); ++i) all += content[i] + " ";
+        features.push_back(hashString(all));
+    }
+    for (size_t i = 0; i + 2 < content.size(); ++i)
+        features.push_back(hashString(content[i] + " " + content[i + 1] + " " + content[i + 2]));
+    sig.hasText = !features.empty();
+    minHash(features, sig.text);
+}
+
+bool DuplicateDetector::isDuplicate(const Signature &a, const Signature &b, Candidate &result) const {
+    result.skillSimilarity = (a.hasSkills && b.hasSkills) ? similarity(a.skills, b.skills) : 0.0;
+    result.textSimilarity = (a.hasText && b.hasText) ? similarity(a.text, b.text) : 0.0;
+    return result.skillSimilarity >= skillThreshold || result.textSimilarity >= textThreshold;
+}
+
+// ---------------- listener hooks ----------------
+void DuplicateDetector::onInsert(int id, const string &title, const string &description, const string keywords[10]) {
+    Signature &sig = signatures[id];
+    buildSignature(title, description, keywords, sig);
+    for (int band = 0; band < BANDS; ++band) {
+        if (sig.hasSkills) skillBuckets[bandKey(sig.skills, band)].push_back(id);
+        if (sig.hasText) textBuckets[bandKey(sig.text, band)].push_back(id);
+    }
+}
+
+static void removeFromBucket(unordered_map<uint64_t, vector<int> > &buckets, uint64_t key, int id) {
+    unordered_map<uint64_t, vector<int> >::iterator it = buckets.find(key);
+    if (it == buckets.end()) return;
+    vector<int> &ids = it->second;
+    ids.erase(remove(ids.begin(), ids.end(), id), ids.end());
+    if (ids.empty()) buckets.erase(it);
+}
+
+void DuplicateDetector::onRemove(int id, const string &, const string &, const string [10]) {
+    unordered_map<int, Signature>::iterator it = signatures.find(id);
+    if (it == signatures.end()) return;
+    for (int band = 0; band < BANDS; ++band) {
+        if (it->second.hasSkills) removeFromBucket(skillBuckets, bandKey(it->second.skills, band), id);
+        if (it->second.hasText) removeFromBucket(textBuckets, bandKey(it->second.text, band), id);
+    }
+    signatures.erase(it);
+}
+
+void DuplicateDetector::onClear() {
+    signatures.clear();
+    skillBuckets.clear();
+    textBuckets.clear();
+}
+
+// ---------------- queries ----------------
+vector<DuplicateDetector::Candidate> DuplicateDetector::findDuplicates(int id) const {
+    vector<Candidate> result;
+    unordered_map<int, Signature>::const_iterator self = signatures.find(id);
+    if (self == signatures.end()) return result;
+
+    unordered_set<int> seen;
+    seen.insert(id);
+    const Signature &sig = self->second;
+    for (int table = 0; table < 2; ++table) {
+        bool skills = (table == 0);
+        if (skills ? !sig.hasSkills : !sig.hasText) continue;
+        const unordered_map<uint64_t, vector<int> > &buckets = skills ? skillBuckets : textBuckets;
+
+        for (int band = 0; band < BANDS; ++band) {
+            unordered_map<uint64_t, vector<int> >::const_iterator b =
+                buckets.find(bandKey(skills ? sig.skills : sig.text, band));
+            if (b == buckets.end()) continue;
+            for (size_t k = 0; k < b->second.size(); ++k) {
+                int other = b->second[k];
+                if (!seen.insert(other).second) continue;
+                Candidate c;
+                c.id = other;
+                if (isDuplicate(sig, signatures.at(other), c)) result.push_back(c);
+            }
+        }
+    }
+
+    sort(result.begin(), result.end(), [](const Candidate &a, const Candidate &b) {
+        double sa = max(a.skillSimilarity, a.textSimilarity), sb = max(b.skillSimilarity, b.textSimilarity);
+        return (sa != sb) ? sa > sb : a.id < b.id;
+    });
+    return result;
+}
+
+void DuplicateDetector::reportDuplicates(int id, const string &recordType) const {
+    auto start = high_resolution_clock::now();
+    vector<Candidate> dups = findDuplicates(id);
+    auto end = high_resolution_clock::now();
+
+    if (!dups.empty()) {
+        cout << "Warning: possible duplicate of " << dups.size() << " existing " << recordType << "(s):\n";
+        for (size_t i = 0; i < dups.size() && i < 5; ++i)
+            cout << "  " << recordType << " [" << dups[i].id << "] (skills "
+                 << (int)(dups[i].skillSimilarity * 100) << "%, text "
+                 << (int)(dups[i].textSimilarity * 100) << "%)\n";
+        if (dups.size() > 5) cout << "  ... and " << dups.size() - 5 << " more\n";
+    }
+    cout << "[Performance] duplicate check execution time: "
+         << duration_cast<microseconds>(end - start).count() << " microseconds\n";
+    recordLatency("duplicate_check", recordType, duration_cast<microseconds>(end - start).count());
+    if (!dups.empty()) MetricsRegistry::instance().increment("duplicates_flagged", recordType);
+}
+
+// Union-find over record positions
+static int findRoot(vector<int> &parent, int x) {
+    while (parent[x] != x) {
+        parent[x] = parent[parent[x]];
+        x = parent[x];
+    }
+    return x;
+}
+
+vector<vector<int> > DuplicateDetector::findClusters() const {
+    vector<int> ids;
+    ids.reserve(signatures.size());
+    for (unordered_map<int, Signature>::const_iterator it = signatures.begin(); it != signatures.end(); ++it)
+        ids.push_back(it->first);
+    sort(ids.begin(), ids.end());
+    unordered_map<int, int> position;
+    for (size_t i = 0; i < ids.size(); ++i) position[ids[i]] = (int)i;
+
+    vector<int> parent(ids.size());
+    for (size_t i = 0; i < parent.size(); ++i) parent[i] = (int)i;
+
+    // Inside a bucket each member is checked against the bucket's first
+    // member and its predecessor only: linear per bucket, and records that
+    // really are similar meet again in other bands
+    Candidate scratch;
+    for (int table = 0; table < 2; ++table) {
+        const unordered_map<uint64_t, vector<int> > &buckets = (table == 0) ? skillBuckets : textBuckets;
+        for (unordered_map<uint64_t, vector<int> >::const_iterator b = buckets.begin(); b != buckets.end(); ++b) {
+            const vector<int> &members = b->second;
+            for (size_t k = 1; k < members.size(); ++k) {
+                const Signature &sig = signatures.at(members[k]);
+                int pk = position[members[k]];
+                int anchors[2] = { members[0], members[k - 1] };
+                for (int a = 0; a < 2; ++a) {
+                    int pa = position[anchors[a]];
+                    if (findRoot(parent, pk) == findRoot(parent, pa)) continue;
+                    if (isDuplicate(sig, signatures.at(anchors[a]), scratch))
+                        parent[findRoot(parent, pk)] = findRoot(parent, pa);
+                }
+            }
+        }
+    }
+
+    unordered_map<int, vector<int> > groups;
+    for (size_t i = 0; i < ids.size(); ++i)
+        groups[findRoot(parent, (int)i)].push_back(ids[i]);
+
+    vector<vector<int> > clusters;
+    for (unordered_map<int, vector<int> >::iterator g = groups.begin(); g != groups.end(); ++g)
+        if (g->second.size() > 1) clusters.push_back(g->second);
+    sort(clusters.begin(), clusters.end(), [](const vector<int> &a, const vector<int> &b) {
+        return (a.size() != b.size()) ? a.size() > b.size() : a[0] < b[0];
+    });
+    return clusters;
+}
+
+size_t DuplicateDetector::memoryBytes() const {
+    size_t bytes = sizeof(*this);
+    bytes += signatures.size() * (sizeof(int) + sizeof(Signature) + 2 * sizeof(void*));
+    const unordered_map<uint64_t, vector<int> > *tables[2] = { &skillBuckets, &textBuckets };
+    for (int t = 0; t < 2; ++t)
+        for (unordered_map<uint64_t, vector<int> >::const_iterator b = tables[t]->begin(); b != tables[t]->end(); ++b)
+            bytes += sizeof(*b) + 2 * sizeof(void*) + b->second.capacity() * sizeof(int);
+    return bytes;
+}
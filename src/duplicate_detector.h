@@ -0,0 +1,75 @@
+#ifndef DUPLICATE_DETECTOR_H
+#define DUPLICATE_DETECTOR_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include "record_listener.h"
+using namespace std;
+
+// Near-duplicate detection with MinHash + locality-sensitive hashing.
+// Each record gets two MinHash signatures computed at ingest:
+//   skills - the normalized skill set (plus the title for jobs), so the same
+//            skills in a different order hash identically
+//   text   - 3-word shingles of the description without stop words
+// Signatures are cut into BANDS bands of ROWS values, and each band is
+// hashed into a bucket table. Only records that share a bucket are ever
+// compared, so finding duplicates never looks at all pairs.
+// Two records are duplicates when either estimated Jaccard similarity
+// reaches its threshold.
+class DuplicateDetector : public RecordListener {
+public:
+    static const int HASHES = 32;          // MinHash values per signature
+    static const int BANDS = 8;
+    static const int ROWS = HASHES / BANDS;
+
+    struct Candidate {
+        int id;
+        double skillSimilarity;            // estimated Jaccard, 0..1
+        double textSimilarity;
+    };
+
+private:
+    struct Signature {
+        uint32_t skills[HASHES];
+        uint32_t text[HASHES];
+        bool hasSkills;
+        bool hasText;
+    };
+
+    double skillThreshold;
+    double textThreshold;
+    unordered_map<int, Signature> signatures;              // record ID -> signature
+    unordered_map<uint64_t, vector<int> > skillBuckets;    // band hash -> record IDs
+    unordered_map<uint64_t, vector<int> > textBuckets;
+
+    static void minHash(const vector<uint64_t> &features, uint32_t out[HASHES]);
+    static uint64_t bandKey(const uint32_t sig[HASHES], int band);
+    static double similarity(const uint32_t a[HASHES], const uint32_t b[HASHES]);
+
+    void buildSignature(const string &title, const string &description,
+                        const string keywords[10], Signature &sig) const;
+    bool isDuplicate(const Signature &a, const Signature &b, Candidate &result) const;
+
+public:
+    explicit DuplicateDetector(double skillThreshold = 0.9, double textThreshold = 0.8);
+
+    void onInsert(int id, const string &title, const string &description, const string keywords[10]);
+    void onRemove(int id, const string &title, const string &description, const string keywords[10]);
+    void onClear();
+
+    // Records that look like duplicates of record id (most similar first)
+    vector<Candidate> findDuplicates(int id) const;
+
+    // Prints a warning listing the duplicates of a freshly added record
+    void reportDuplicates(int id, const string &recordType) const;
+
+    // Groups of two or more near-identical records, largest group first
+    vector<vector<int> > findClusters() const;
+
+    size_t recordCount() const { return signatures.size(); }
+    size_t memoryBytes() const;
+};
+
+#endif
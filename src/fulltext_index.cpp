@@ -0,0 +1,246 @@
+#include "fulltext_index.h"
+#include <algorithm>
+using namespace std;
+
+// Tombstones are squeezed out once there are this many and they make up a
+// quarter of the indexed records
+static const size_t COMPACT_MIN_TOMBSTONES = 64;
+
+// ---------------- varint coding ----------------
+static void putVarint(vector<unsigned char> &out, unsigned int value) {
+    while (value >= 0x80) {
+        out.push_back((unsigned char)(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back((unsigned char)value);
+}
+
+static unsigned int getVarint(const unsigned char *&p) {
+    unsigned int value = 0;
+    int shift = 0;
+    while (*p & 0x80) {
+        value |= (unsigned int)(*p++ & 0x7F) << shift;
+        shift += 7;
+    }
+    value |= (unsigned int)(*p++) << shift;
+    return value;
+}
+
+// Sequential reader over one term's encoded postings
+namespace {
+struct PostingCursor {
+    const unsigned char *p;
+    const unsigned char *end;
+    int doc;
+    vector<int> positions;
+
+    PostingCursor(const vector<unsigned char> &bytes)
+        : p(bytes.data()), end(bytes.data() + bytes.size()), doc(0) {}
+
+    bool next(bool wantPositions) {
+        if (p >= end) return false;
+        doc += (int)getVarint(p);
+        unsigned int tf = getVarint(p);
+        positions.clear();
+        int pos = 0;
+        for (unsigned int k = 0; k < tf; ++k) {
+            pos += (int)getVarint(p);
+            if (wantPositions) positions.push_back(pos);
+        }
+        return true;
+    }
+};
+}
+
+FullTextIndex::FullTextIndex() : liveRecords(0) {}
+
+// ---------------- ingest ----------------
+// Containers assign ascending IDs (last ID + 1), so every posting is an append.
+void FullTextIndex::onInsert(int id, const string &, const string &description, const string [10]) {
+    if (deleted.count(id)) compact();   // a tail delete followed by an add reuses the ID
+
+    tokenizeText(description, words);
+    docTerms.clear();
+    for (size_t pos = 0; pos < words.size(); ++pos) {
+        if (isStopWord(words[pos])) continue;
+
+        int termID;
+        unordered_map<string, int>::iterator it = termIDs.find(words[pos]);
+        if (it != termIDs.end()) {
+            termID = it->second;
+        } else {
+            termID = (int)postings.size();
+            termIDs[words[pos]] = termID;
+            postings.push_back(TermPostings());
+        }
+        docTerms[termID].push_back((int)pos);
+    }
+
+    for (unordered_map<int, vector<int> >::iterator it = docTerms.begin(); it != docTerms.end(); ++it) {
+        TermPostings &tp = postings[it->first];
+        if (id <= tp.lastDoc) continue;   // out-of-order ID: cannot append
+        putVarint(tp.bytes, (unsigned int)(id - tp.lastDoc));
+        putVarint(tp.bytes, (unsigned int)it->second.size());
+        int prev = 0;
+        for (size_t k = 0; k < it->second.size(); ++k) {
+            putVarint(tp.bytes, (unsigned int)(it->second[k] - prev));
+            prev = it->second[k];
+        }
+        tp.lastDoc = id;
+        tp.docCount++;
+    }
+    liveRecords++;
+}
+
+void FullTextIndex::onRemove(int id, const string &, const string &, const string [10]) {
+    deleted.insert(id);
+    liveRecords--;
+    if (deleted.size() >= COMPACT_MIN_TOMBSTONES && deleted.size() * 4 >= (size_t)liveRecords)
+        compact();
+}
+
+void FullTextIndex::onClear() {
+    termIDs.clear();
+    postings.clear();
+    deleted.clear();
+    liveRecords = 0;
+}
+
+// Re-encode every posting list without the tombstoned records
+void FullTextIndex::compact() {
+    if (deleted.empty()) return;
+    for (size_t t = 0; t < postings.size(); ++t) {
+        TermPostings &tp = postings[t];
+        TermPostings rebuilt;
+        PostingCursor cur(tp.bytes);
+        while (cur.next(true)) {
+            if (deleted.count(cur.doc)) continue;
+            putVarint(rebuilt.bytes, (unsigned int)(cur.doc - rebuilt.lastDoc));
+            putVarint(rebuilt.bytes, (unsigned int)cur.positions.size());
+            int prev = 0;
+            for (size_t k = 0; k < cur.positions.size(); ++k) {
+                putVarint(rebuilt.bytes, (unsigned int)(cur.positions[k] - prev));
+                prev = cur.positions[k];
+            }
+            rebuilt.lastDoc = cur.doc;
+            rebuilt.docCount++;
+        }
+        rebuilt.bytes.shrink_to_fit();
+        tp = rebuilt;
+    }
+    deleted.clear();
+}
+
+// ---------------- query ----------------
+void FullTextIndex::decodeDocs(int termID, PostingList &docs) const {
+    docs.clear();
+    docs.reserve(postings[termID].docCount);
+    PostingCursor cur(postings[termID].bytes);
+    while (cur.next(false))
+        if (deleted.empty() || !deleted.count(cur.doc)) docs.push_back(cur.doc);
+}
+
+// Records containing the words of phrase at the same relative positions
+bool FullTextIndex::phraseMatches(const vector<string> &phrase, PostingList &docs) const {
+    docs.clear();
+    vector<int> terms, offsets;
+    for (size_t i = 0; i < phrase.size(); ++i) {
+        if (isStopWord(phrase[i])) continue;
+        unordered_map<string, int>::const_iterator it = termIDs.find(phrase[i]);
+        if (it == termIDs.end()) return false;
+        terms.push_back(it->second);
+        offsets.push_back((int)i);
+    }
+    if (terms.empty()) return false;
+    if (terms.size() == 1) {
+        decodeDocs(terms[0], docs);
+        return true;
+    }
+
+    vector<PostingCursor> cursors;
+    for (size_t i = 0; i < terms.size(); ++i) {
+        cursors.push_back(PostingCursor(postings[terms[i]].bytes));
+        if (!cursors.back().next(true)) return true;
+    }
+
+    while (true) {
+        // Leapfrog: advance every cursor to the largest current record
+        int target = cursors[0].doc;
+        for (size_t i = 1; i < cursors.size(); ++i) target = max(target, cursors[i].doc);
+        bool aligned = true;
+        for (size_t i = 0; i < cursors.size(); ++i) {
+            while (cursors[i].doc < target)
+                if (!cursors[i].next(true)) return true;
+            if (cursors[i].doc != target) aligned = false;
+        }
+        if (!aligned) continue;
+
+        if (deleted.empty() || !deleted.count(target)) {
+            const vector<int> &first = cursors[0].positions;
+            for (size_t k = 0; k < first.size(); ++k) {
+                int start = first[k] - offsets[0];
+                bool all = true;
+                for (size_t i = 1; i < cursors.size() && all; ++i)
+                    all = binary_search(cursors[i].positions.begin(), cursors[i].positions.end(),
+                                        start + offsets[i]);
+                if (all) {
+                    docs.push_back(target);
+                    break;
+                }
+            }
+        }
+        if (!cursors[0].next(true)) return true;
+    }
+}
+
+PostingList FullTextIndex::search(const string &query) const {
+    // Split into "quoted phrases" and single words; each is one condition
+    vector<vector<string> > phrases;
+    vector<string> tokens;
+    size_t i = 0;
+    while (i < query.size()) {
+        size_t quote = query.find('"', i);
+        string plain = query.substr(i, (quote == string::npos) ? string::npos : quote - i);
+        tokenizeText(plain, tokens);
+        for (size_t k = 0; k < tokens.size(); ++k)
+            if (!isStopWord(tokens[k])) phrases.push_back(vector<string>(1, tokens[k]));
+        if (quote == string::npos) break;
+
+        size_t close = query.find('"', quote + 1);
+        if (close == string::npos) close = query.size();
+        tokenizeText(query.substr(quote + 1, close - quote - 1), tokens);
+        if (!tokens.empty()) phrases.push_back(tokens);
+        i = close + 1;
+    }
+
+    PostingList result, part, next;
+    bool first = true;
+    for (size_t p = 0; p < phrases.size(); ++p) {
+        if (!phraseMatches(phrases[p], part)) {
+            bool onlyStopWords = true;
+            for (size_t k = 0; k < phrases[p].size(); ++k)
+                if (!isStopWord(phrases[p][k])) onlyStopWords = false;
+            if (onlyStopWords) continue;   // nothing to look for
+            return PostingList();          // unknown word
+        }
+        if (first) {
+            result.swap(part);
+            first = false;
+        } else {
+            intersectPostings(result, part, next);
+            result.swap(next);
+        }
+        if (result.empty()) break;
+    }
+    return result;
+}
+
+size_t FullTextIndex::memoryBytes() const {
+    size_t bytes = sizeof(*this);
+    for (size_t t = 0; t < postings.size(); ++t)
+        bytes += sizeof(TermPostings) + postings[t].bytes.capacity();
+    for (unordered_map<string, int>::const_iterator it = termIDs.begin(); it != termIDs.end(); ++it)
+        bytes += sizeof(*it) + 2 * sizeof(void*) + (it->first.capacity() > 15 ? it->first.capacity() + 1 : 0);
+    bytes += deleted.size() * (sizeof(int) + 2 * sizeof(void*));
+    return bytes;
+}
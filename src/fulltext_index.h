@@ -0,0 +1,56 @@
+#ifndef FULLTEXT_INDEX_H
+#define FULLTEXT_INDEX_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include "record_listener.h"
+#include "posting_ops.h"
+#include "utility.h"
+using namespace std;
+
+// Positional inverted index over the whole description text.
+// Postings are built during ingest and stored delta + varint encoded:
+//   per record: docGap, termFrequency, positionGap * termFrequency
+// Deleted records are tombstoned and squeezed out once they pile up.
+class FullTextIndex : public RecordListener {
+private:
+    struct TermPostings {
+        vector<unsigned char> bytes;
+        int lastDoc;
+        int docCount;
+        TermPostings() : lastDoc(0), docCount(0) {}
+    };
+
+    unordered_map<string, int> termIDs;
+    vector<TermPostings> postings;
+    unordered_set<int> deleted;          // tombstones not yet compacted
+    int liveRecords;
+
+    // Scratch reused across inserts to avoid per-record allocations
+    vector<string> words;
+    unordered_map<int, vector<int> > docTerms;
+
+    void compact();
+    void decodeDocs(int termID, PostingList &docs) const;
+    bool phraseMatches(const vector<string> &phrase, PostingList &docs) const;
+
+public:
+    FullTextIndex();
+
+    void onInsert(int id, const string &title, const string &description, const string keywords[10]);
+    void onRemove(int id, const string &title, const string &description, const string keywords[10]);
+    void onClear();
+
+    // Query: bare words and "quoted phrases", all of which must appear.
+    // Case-insensitive; stop words inside a phrase keep their slot.
+    // Returns sorted record IDs.
+    PostingList search(const string &query) const;
+
+    int termCount() const { return (int)postings.size(); }
+    int recordCount() const { return liveRecords; }
+    size_t memoryBytes() const;         // encoded postings + dictionary
+};
+
+#endif
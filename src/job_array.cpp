@@ -5,18 +5,29 @@
 #include <algorithm>
 #include <cctype>
 #include <chrono>
-#include <windows.h>
-#include <psapi.h>
 #include "utility.h"
+#include "autocomplete.h"
+#include "duplicate_detector.h"
+#include "metrics.h"
+#include "trace.h"
+#include "memory_accounting.h"
+#include "snapshot_writer.h"
+#include "bulk_import.h"
+#include "record_filter.h"
+#include "skill_ontology.h"
 using namespace std;
 using namespace std::chrono;
 
+static const int MEMORY_STORE = MemoryAccounting::registerStore("Job Array");
+
 // ---------------- Constructor / Destructor ----------------
 JobArray::JobArray() {
     jobs = nullptr;
     jobsCount = 0;
     jobsCapacity = 0;
     csvFilename = "";
+    titleCompleter = nullptr;
+    duplicates = nullptr;
 }
 
 JobArray::~JobArray() {
@@ -27,12 +38,13 @@ JobArray::~JobArray() {
 void JobArray::ensureCapacity(int minCapacity) {
     if (minCapacity <= jobsCapacity) return;
 
+    TRACE_SCOPE("ensureCapacity (grow)");
     int newCapacity = max(100, jobsCapacity * 2);
     if (newCapacity < minCapacity) newCapacity = minCapacity;
 
     Job *newJobs = new Job[newCapacity];
     for (int i = 0; i < jobsCount; ++i)
-        newJobs[i] = jobs[i];
+        newJobs[i] = std::move(jobs[i]);   // strings keep their buffers
 
     delete[] jobs;
     jobs = newJobs;
@@ -40,27 +52,29 @@ void JobArray::ensureCapacity(int minCapacity) {
 }
 
 // ---------------- extractInfo ----------------
-static void extractInfo(Job &job) {
-    string desc = job.description;
+void JobArray::extractInfo(Job &job) {
+    TRACE_SCOPE("extractInfo");
+    const string text = job.description.str();   // still plain at insert time
+    string desc = text;
     transform(desc.begin(), desc.end(), desc.begin(), ::tolower);
 
     size_t phrasePos = desc.find("needed with experience");
     if (phrasePos == string::npos) {
-        stringstream ss(job.description);
+        stringstream ss(text);
         ss >> job.title;
         return;
     }
 
-    job.title = job.description.substr(0, phrasePos);
+    job.title = text.substr(0, phrasePos);
     while (!job.title.empty() && isspace(job.title.back()))
         job.title.pop_back();
 
     size_t startPos = phrasePos + string("needed with experience").length();
-    size_t endPos = job.description.find('.', startPos);
+    size_t endPos = text.find('.', startPos);
     if (endPos == string::npos)
-        endPos = job.description.length();
+        endPos = text.length();
 
-    string skills = job.description.substr(startPos, endPos - startPos);
+    string skills = text.substr(startPos, endPos - startPos);
     if (skills.find(" in ") == 0) skills.erase(0, 4);
     skills.erase(0, skills.find_first_not_of(" "));
     skills.erase(skills.find_last_not_of(" ") + 1);
@@ -74,20 +88,39 @@ static void extractInfo(Job &job) {
         if (!token.empty()) job.keywords[idx++] = token;
     }
     for (int i = idx; i < 10; ++i) job.keywords[i] = "";
+    SkillOntology::canonicalize(job.keywords);   // "ML" is stored as "Machine Learning"
 }
 
 // ---------------- insertAtEnd ----------------
 void JobArray::insertAtEnd(const string &desc) {
-    ensureCapacity(jobsCount + 1);
+    {
+        MemoryScope scope(MEMORY_STORE, MemoryAccounting::NODES);
+        ensureCapacity(jobsCount + 1);
+    }
+    int id = (jobsCount > 0) ? jobs[jobsCount - 1].jobID + 1 : 1;  // IDs stay unique after deletes
     Job &job = jobs[jobsCount++];
-    job.jobID = jobsCount;
-    job.description = desc;
-    extractInfo(job);
+    job.jobID = id;
+    {
+        MemoryScope scope(MEMORY_STORE, MemoryAccounting::DESCRIPTIONS);
+        job.description = desc;
+    }
+    {
+        MemoryScope scope(MEMORY_STORE, MemoryAccounting::KEYWORDS);
+        extractInfo(job);
+    }
+    {
+        MemoryScope scope(MEMORY_STORE, MemoryAccounting::INDEXES);
+        notifyInsert(job);
+    }
+    MemoryScope scope(MEMORY_STORE, MemoryAccounting::DESCRIPTIONS);
+    job.description.pack();   // the indexes have seen the plain text
 }
 
 // ---------------- loadFromCSV ----------------
 void JobArray::loadFromCSV(const string &filename) {
+    TRACE_SCOPE("loadFromCSV [Job Array]");
     double memBefore = getCurrentMemoryKB();  // record before loading
+    long long heapBefore = MemoryAccounting::storeBytes(MEMORY_STORE);
     auto start = high_resolution_clock::now();
 
     ifstream file(filename);
@@ -100,7 +133,7 @@ void JobArray::loadFromCSV(const string &filename) {
     string line;
     getline(file, line); // skip header
 
-    while (getline(file, line)) {
+    while (tracedGetline(file, line)) {
         if (line.empty()) continue;
         insertAtEnd(line);
     }
@@ -113,35 +146,95 @@ void JobArray::loadFromCSV(const string &filename) {
     cout << "[Performance] loadFromCSV [Job Array] execution time: "
          << duration_cast<microseconds>(end - start).count()
          << " microseconds\n";
+    recordLatency("load", "Array", duration_cast<microseconds>(end - start).count());
 
     cout << "[Memory] loadFromCSV [Job Array] memory space: "
+         << (MemoryAccounting::storeBytes(MEMORY_STORE) - heapBefore) / 1024 << " KB allocated, RSS +"
          << (memAfter - memBefore) << " KB\n\n";
 }
 
 
 // ---------------- saveToCSV ----------------
 void JobArray::saveToCSV(const string &filename) {
-    // Note: Performance timer stops BEFORE file writing.
+    TRACE_SCOPE("saveToCSV [Job Array]");
+    // Only the snapshot is taken here; the file is written in the background
     auto start = high_resolution_clock::now();
 
+    string content = "job_description\n";
+    for (int i = 0; i < jobsCount; ++i) {
+        content += '"';
+        jobs[i].description.appendTo(content);
+        content += "\"\n";
+    }
+    long long generation = SnapshotWriter::instance().submit(filename, std::move(content));
+
     auto end = high_resolution_clock::now();
+    cout << "Saving " << jobsCount << " records to " << filename << " in the background (generation "
+         << generation << ")\n";
     cout << "[Performance] (pre-save) processing time: "
          << duration_cast<microseconds>(end - start).count()
          << " microseconds\n";
+    recordLatency("save", "Array", duration_cast<microseconds>(end - start).count());
+}
 
-    // File I/O (not included in timing)
-    ofstream file(filename);
+// ---------------- bulkImport ----------------
+int JobArray::bulkImport(const string &filename) {
+    ifstream file(filename);
     if (!file.is_open()) {
-        cout << "Error: Cannot open " << filename << " for writing\n";
-        return;
+        cout << "Error: Cannot open " << filename << endl;
+        return 0;
     }
+    return bulkImport(file);
+}
 
-    file << "job_description\n";
-    for (int i = 0; i < jobsCount; ++i)
-        file << "\"" << jobs[i].description << "\"\n";
+int JobArray::bulkImport(istream &in) {
+    TRACE_SCOPE("bulkImport [Job Array]");
+    auto start = high_resolution_clock::now();
 
-    file.close();
-    cout << "Successfully saved " << jobsCount << " records to " << filename << endl;
+    vector<string> lines;
+    {
+        MemoryScope scope(MEMORY_STORE, MemoryAccounting::DESCRIPTIONS);
+        readImportLines(in, "job_description", lines);
+    }
+    int added = (int)lines.size();
+    if (added == 0) {
+        cout << "No jobs to import.\n";
+        return 0;
+    }
+
+    {
+        MemoryScope scope(MEMORY_STORE, MemoryAccounting::NODES);
+        ensureCapacity(jobsCount + added);   // one grow for the whole batch
+    }
+    int firstID = (jobsCount > 0) ? jobs[jobsCount - 1].jobID + 1 : 1;
+    Job *batch = jobs + jobsCount;
+    for (int i = 0; i < added; ++i) {
+        batch[i].jobID = firstID + i;
+        batch[i].description = std::move(lines[i]);   // keeps its DESCRIPTIONS tag
+    }
+
+    parallelChunks(added, "import worker", [batch](int begin, int end) {
+        MemoryScope scope(MEMORY_STORE, MemoryAccounting::KEYWORDS);
+        for (int i = begin; i < end; ++i) extractInfo(batch[i]);
+    });
+    jobsCount += added;
+
+    {
+        MemoryScope scope(MEMORY_STORE, MemoryAccounting::INDEXES);
+        for (int i = 0; i < added; ++i) notifyInsert(batch[i]);
+        for (size_t i = 0; i < listeners.size(); ++i) listeners[i]->onBatchEnd();
+    }
+    parallelChunks(added, "import worker", [batch](int begin, int end) {
+        MemoryScope scope(MEMORY_STORE, MemoryAccounting::DESCRIPTIONS);
+        for (int i = begin; i < end; ++i) batch[i].description.pack();
+    });
+
+    auto end = high_resolution_clock::now();
+    reportBulkImport("Job Array", "Array", added, duration_cast<microseconds>(end - start).count());
+
+    if (!csvFilename.empty()) saveToCSV(csvFilename);
+    else cout << "Warning: No CSV filename stored.\n";
+    return added;
 }
 
 // ---------------- display ----------------
@@ -189,6 +282,7 @@ void JobArray::addRecord() {
     cout << "\n=== ADD NEW JOB ===\n";
     cout << "Enter job title: ";
     getline(cin, jobTitle);
+    jobTitle = offerCompletions(titleCompleter, jobTitle);
     cout << "Enter required skills (comma-separated): ";
     getline(cin, skills);
 
@@ -203,6 +297,9 @@ void JobArray::addRecord() {
     cout << "[Performance] addRecord (processing) execution time: "
          << duration_cast<microseconds>(end - start).count()
          << " microseconds\n";
+    recordLatency("add", "Array", duration_cast<microseconds>(end - start).count());
+
+    if (duplicates) duplicates->reportDuplicates(jobs[jobsCount - 1].jobID, "Job");
 
     // 3) Ask user whether to save (do not include this interaction in the processing time)
     if (confirmAction("Save to CSV?")) {
@@ -216,42 +313,84 @@ void JobArray::addRecord() {
 }
 
 
+bool JobArray::removeAt(int position) {
+    if (position < 1 || position > jobsCount) return false;
+    notifyRemove(jobs[position - 1]);
+    for (int i = position; i < jobsCount; ++i)
+        jobs[i - 1] = std::move(jobs[i]);
+    jobsCount--;
+    return true;
+}
+
 void JobArray::deleteFromMiddle(int position) {
     auto start = high_resolution_clock::now();
 
-    if (position < 1 || position > jobsCount) {
+    if (!removeAt(position)) {
         cout << "Invalid position.\n";
         return;
     }
-    for (int i = position; i < jobsCount; ++i)
-        jobs[i - 1] = jobs[i];
-    jobsCount--;
     cout << "Deleted record at position " << position << ".\n";
 
     auto end = high_resolution_clock::now();
     cout << "[Performance] deleteFromMiddle execution time: "
          << duration_cast<microseconds>(end - start).count()
          << " microseconds\n";
+    recordLatency("delete", "Array", duration_cast<microseconds>(end - start).count());
 }
 
 void JobArray::deleteFromTail() {
     auto start = high_resolution_clock::now();
 
-    if (jobsCount == 0) {
+    if (!removeAt(jobsCount)) {
         cout << "Array is empty.\n";
         return;
     }
-    jobsCount--;
     cout << "Deleted last record.\n";
 
     auto end = high_resolution_clock::now();
     cout << "[Performance] deleteFromTail execution time: "
          << duration_cast<microseconds>(end - start).count()
          << " microseconds\n";
+    recordLatency("delete", "Array", duration_cast<microseconds>(end - start).count());
+}
+
+// ---------------- removeWhere ----------------
+int JobArray::removeWhere(const RecordPredicate &predicate) {
+    TRACE_SCOPE("removeWhere [Job Array]");
+    auto start = high_resolution_clock::now();
+
+    // Survivors are moved down over the gaps as the pass goes, so each record
+    // moves at most once instead of the whole tail shifting per delete
+    int kept = 0;
+    for (int i = 0; i < jobsCount; ++i) {
+        Job &job = jobs[i];
+        if (predicate.matches(job.jobID, job.title, job.description, job.keywords)) {
+            notifyRemove(job);
+            continue;
+        }
+        if (kept != i) jobs[kept] = std::move(job);
+        kept++;
+    }
+    int removed = jobsCount - kept;
+    for (int i = kept; i < jobsCount; ++i) jobs[i] = Job();   // free what removed records left behind
+    jobsCount = kept;
+    if (removed > 0)
+        for (size_t i = 0; i < listeners.size(); ++i) listeners[i]->onBatchEnd();
+
+    auto end = high_resolution_clock::now();
+    reportBulkDelete("Job Array", "Array", predicate, removed, jobsCount,
+                     duration_cast<microseconds>(end - start).count());
+
+    if (removed > 0) {
+        if (!csvFilename.empty()) saveToCSV(csvFilename);
+        else cout << "Warning: No CSV filename stored.\n";
+    }
+    return removed;
 }
 
 // ---------------- Utility ----------------
 void JobArray::clear() {
+    detachListeners();
     delete[] jobs;
     jobs = nullptr;
     jobsCount = 0;
@@ -263,9 +402,17 @@ int JobArray::getSize() const {
 }
 
 Job* JobArray::findJobByID(int jobID) {
-    for (int i = 0; i < jobsCount; ++i)
-        if (jobs[i].jobID == jobID)
-            return &jobs[i];
+    return const_cast<Job*>(findByID(jobID));
+}
+
+const Job* JobArray::findByID(int jobID) const {
+    int lo = 0, hi = jobsCount - 1;
+    while (lo <= hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (jobs[mid].jobID == jobID) return &jobs[mid];
+        if (jobs[mid].jobID < jobID) lo = mid + 1;
+        else hi = mid - 1;
+    }
     return nullptr;
 }
 
@@ -273,6 +420,50 @@ const Job& JobArray::getJob(int index) const {
     return jobs[index];
 }
 
+// ---------------- listeners ----------------
+void JobArray::addListener(RecordListener *listener) {
+    listeners.push_back(listener);
+    for (int i = 0; i < jobsCount; ++i)
+        listener->onInsert(jobs[i].jobID, jobs[i].title, jobs[i].description.str(), jobs[i].keywords);
+}
+
+void JobArray::reextractKeywords() {
+    TRACE_SCOPE("reextractKeywords");
+    {
+        MemoryScope scope(MEMORY_STORE, MemoryAccounting::INDEXES);
+        detachListeners();   // shared listeners must see the old keywords go
+    }
+    {
+        MemoryScope scope(MEMORY_STORE, MemoryAccounting::KEYWORDS);
+        for (int i = 0; i < jobsCount; ++i) extractInfo(jobs[i]);
+    }
+    MemoryScope scope(MEMORY_STORE, MemoryAccounting::INDEXES);
+    for (int i = 0; i < jobsCount; ++i) notifyInsert(jobs[i]);
+    for (size_t i = 0; i < listeners.size(); ++i) listeners[i]->onBatchEnd();
+}
+
+void JobArray::detachListeners() {
+    for (size_t l = 0; l < listeners.size(); ++l) {
+        if (!listeners[l]->sharedBetweenStores()) {
+            listeners[l]->onClear();
+            continue;
+        }
+        for (int i = 0; i < jobsCount; ++i)
+            listeners[l]->onRemove(jobs[i].jobID, jobs[i].title, jobs[i].description.str(), jobs[i].keywords);
+    }
+}
+
+void JobArray::notifyInsert(const Job &job) {
+    TRACE_SCOPE("notifyListeners");
+    for (size_t i = 0; i < listeners.size(); ++i)
+        listeners[i]->onInsert(job.jobID, job.title, job.description.str(), job.keywords);
+}
+
+void JobArray::notifyRemove(const Job &job) {
+    for (size_t i = 0; i < listeners.size(); ++i)
+        listeners[i]->onRemove(job.jobID, job.title, job.description.str(), job.keywords);
+}
+
 // ---------------- deleteFromHead ----------------
 void JobArray::deleteFromHead() {
     if (jobsCount == 0) {
@@ -289,22 +480,13 @@ void JobArray::deleteFromHead() {
 
     // Start timing for processing (shifting & bookkeeping) only
     auto start = high_resolution_clock::now();
-
-    // Shift everything left by one
-    for (int i = 1; i < jobsCount; ++i) {
-        jobs[i - 1] = jobs[i];
-    }
-    jobsCount--;
-
-    // Reassign jobID to keep them sequential (1..jobsCount)
-    for (int i = 0; i < jobsCount; ++i) {
-        jobs[i].jobID = i + 1;
-    }
+    removeAt(1);   // IDs stay as they are, so the listeners only drop this record
 
     auto end = high_resolution_clock::now();
     cout << "[Performance] deleteFromHead (processing) execution time: "
          << duration_cast<microseconds>(end - start).count()
          << " microseconds\n";
+    recordLatency("delete", "Array", duration_cast<microseconds>(end - start).count());
 
     // Ask for confirmation to save (do not include save time above)
     if (confirmAction("Job record has been deleted from the array.")) {
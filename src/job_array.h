@@ -2,13 +2,22 @@
 #define JOB_ARRAY_H
 
 #include <string>
+#include <istream>
 #include <stdexcept>
+#include <vector>
+#include "record_listener.h"
+#include "record_store.h"
+#include "text_codec.h"
 using namespace std;
 
+class PrefixCompleter;
+class DuplicateDetector;
+class RecordPredicate;
+
 struct Job {
     int jobID;                // auto ID (same as JobNode)
     string title;             // title before "needed with experience"
-    string description;       // full text
+    PackedText description;   // full text (compressed with --compress)
     string keywords[10];      // max 10 keywords
 };
 
@@ -18,10 +27,17 @@ private:
     int jobsCount;            // number of jobs currently stored
     int jobsCapacity;         // allocated capacity
     string csvFilename;       // store CSV filename for saving
+    vector<RecordListener*> listeners;  // indexes kept in sync with the array
+    PrefixCompleter *titleCompleter;    // optional, used by addRecord()
+    DuplicateDetector *duplicates;      // optional, checked by addRecord()
 
     // Ensure capacity for at least minCapacity elements
     void ensureCapacity(int minCapacity);
 
+    void notifyInsert(const Job &job);
+    void notifyRemove(const Job &job);
+    void detachListeners();           // listeners forget every record of this store
+
 public:
     JobArray();
     ~JobArray();
@@ -29,10 +45,19 @@ public:
     // Insert new job at end (similar to insertAtEnd in linked list)
     void insertAtEnd(const string &desc);
 
+    // Fill title + keywords from the description
+    static void extractInfo(Job &job);
+
     // Load & save
     void loadFromCSV(const string &filename);
     void saveToCSV(const string &filename);
 
+    // Bulk import: append every job in a file or stream as one batch
+    // (one grow, parallel extraction, batched index updates, one save).
+    // Returns the number of jobs added.
+    int bulkImport(const string &filename);
+    int bulkImport(istream &in);
+
     // Utility
     void clear();
     int getSize() const;
@@ -45,7 +70,39 @@ public:
     void deleteFromHead();            // delete first record
     void deleteFromMiddle(int position); // delete from middle (1-based index)
     void deleteFromTail();            // delete last record
-    Job* findJobByID(int jobID);      // find job by ID
+
+    // Silent delete (no output, no prompt, no save) for scripted runs;
+    // listeners are notified. Returns false for an invalid position.
+    bool removeAt(int position);         // 1-based
+
+    // Bulk delete: every job the predicate matches, in one compacting pass,
+    // then one save. Returns how many were removed.
+    int removeWhere(const RecordPredicate &predicate);
+
+    Job* findJobByID(int jobID);      // find job by ID (binary search, IDs ascend)
+
+    // RecordStore contract (record_store.h)
+    typedef Job record_type;
+    typedef const Job* const_iterator;
+    static const bool INDEXED_LOOKUP = true;
+    const_iterator begin() const { return jobs; }
+    const_iterator end() const { return jobs + jobsCount; }
+    int size() const { return jobsCount; }
+    const Job* findByID(int jobID) const;
+    static const char* backendName() { return "Array"; }
+
+    // Register an index/cache to be told about every insert and delete
+    void addListener(RecordListener *listener);
+
+    // Re-extract every record's keywords after the skill ontology is
+    // reloaded, then rebuild the listeners from them
+    void reextractKeywords();
+
+    // Title suggestions offered while typing a new job in addRecord()
+    void setTitleCompleter(PrefixCompleter *completer) { titleCompleter = completer; }
+
+    // Near-duplicate warning printed after addRecord() (detector must also be a listener)
+    void setDuplicateDetector(DuplicateDetector *detector) { duplicates = detector; }
 
     // Helper functions
     bool confirmAction(const string &message);
@@ -5,44 +5,58 @@
 #include <algorithm>
 #include <cctype>
 #include <chrono>
-#include <windows.h>
-#include <psapi.h>
 #include "utility.h"
+#include "autocomplete.h"
+#include "duplicate_detector.h"
+#include "metrics.h"
+#include "trace.h"
+#include "memory_accounting.h"
+#include "snapshot_writer.h"
+#include "bulk_import.h"
+#include "record_filter.h"
+#include "skill_ontology.h"
 using namespace std;
 using namespace std::chrono;
 
+static const int MEMORY_STORE = MemoryAccounting::registerStore("Job Linked List");
+
 JobLinkedList::JobLinkedList() {
     head = tail = nullptr;
     count = 0;
     csvFilename = "";
+    titleCompleter = nullptr;
+    duplicates = nullptr;
 }
 
 JobLinkedList::~JobLinkedList() {
+    listeners.clear();  // listeners may already be destroyed
     clear();
 }
 
 // ---------------- keyword + title extraction ----------------
 void extractInfo(JobNode *node) {
-    string desc = node->description;
+    TRACE_SCOPE("extractInfo");
+    const string text = node->description.str();   // still plain at insert time
+    string desc = text;
     transform(desc.begin(), desc.end(), desc.begin(), ::tolower);
 
     size_t phrasePos = desc.find("needed with experience");
     if (phrasePos == string::npos) {
-        stringstream ss(node->description);
+        stringstream ss(text);
         ss >> node->title;
         return;
     }
 
-    node->title = node->description.substr(0, phrasePos);
+    node->title = text.substr(0, phrasePos);
     while (!node->title.empty() && isspace(node->title.back()))
         node->title.pop_back();
 
     size_t startPos = phrasePos + string("needed with experience").length();
-    size_t endPos = node->description.find('.', startPos);
+    size_t endPos = text.find('.', startPos);
     if (endPos == string::npos)
-        endPos = node->description.length();
+        endPos = text.length();
 
-    string skills = node->description.substr(startPos, endPos - startPos);
+    string skills = text.substr(startPos, endPos - startPos);
 
     if (skills.find(" in ") == 0) skills.erase(0, 4);
     skills.erase(0, skills.find_first_not_of(" "));
@@ -57,13 +71,21 @@ void extractInfo(JobNode *node) {
         if (!token.empty()) node->keywords[idx++] = token;
     }
     for (int i = idx; i < 10; ++i) node->keywords[i] = "";
+    SkillOntology::canonicalize(node->keywords);
 }
 
 // ---------------- insert node ----------------
 void JobLinkedList::insertAtEnd(const string &desc) {
-    JobNode *node = new JobNode();
-    node->jobID = count + 1;
-    node->description = desc;
+    JobNode *node;
+    {
+        MemoryScope scope(MEMORY_STORE, MemoryAccounting::NODES);
+        node = new JobNode();
+    }
+    node->jobID = tail ? tail->jobID + 1 : 1;  // IDs stay unique after deletes
+    {
+        MemoryScope scope(MEMORY_STORE, MemoryAccounting::DESCRIPTIONS);
+        node->description = desc;
+    }
     node->next = nullptr;
 
     if (!head)
@@ -74,13 +96,24 @@ void JobLinkedList::insertAtEnd(const string &desc) {
     }
 
     count++;
-    extractInfo(node);
+    {
+        MemoryScope scope(MEMORY_STORE, MemoryAccounting::KEYWORDS);
+        extractInfo(node);
+    }
+    {
+        MemoryScope scope(MEMORY_STORE, MemoryAccounting::INDEXES);
+        notifyInsert(node);
+    }
+    MemoryScope scope(MEMORY_STORE, MemoryAccounting::DESCRIPTIONS);
+    node->description.pack();   // the indexes have seen the plain text
 }
 
 
 // ---------------- loadFromCSV ----------------
 void JobLinkedList::loadFromCSV(const string &filename) {
+    TRACE_SCOPE("loadFromCSV [Job Linked List]");
     double memBefore = getCurrentMemoryKB();  // record before loading
+    long long heapBefore = MemoryAccounting::storeBytes(MEMORY_STORE);
     auto start = high_resolution_clock::now();
 
     ifstream file(filename);
@@ -95,7 +128,7 @@ void JobLinkedList::loadFromCSV(const string &filename) {
 
     getline(file, line); // skip header
 
-    while (getline(file, line)) {
+    while (tracedGetline(file, line)) {
         if (line.empty()) continue;
         insertAtEnd(line);
         recordCount++;
@@ -110,8 +143,10 @@ void JobLinkedList::loadFromCSV(const string &filename) {
 
     cout << "[Performance] loadFromCSV [Job Linked List] execution time: "
          << duration << " microseconds\n";
+    recordLatency("load", "Linked List", duration);
 
     cout << "[Memory] loadFromCSV [Job Linked List] memory usage: "
+         << (MemoryAccounting::storeBytes(MEMORY_STORE) - heapBefore) / 1024 << " KB allocated, RSS +"
          << (memAfter - memBefore) << " KB\n\n";
 }
 
@@ -151,6 +186,7 @@ void JobLinkedList::addRecord() {
     cout << "\n=== ADD NEW JOB ===\n";
     cout << "Enter job title: ";
     getline(cin, jobTitle);
+    jobTitle = offerCompletions(titleCompleter, jobTitle);
     cout << "Enter required skills (comma-separated, e.g., Python, Java, SQL): ";
     getline(cin, skills);
 
@@ -161,11 +197,13 @@ void JobLinkedList::addRecord() {
     auto endBeforeSave = high_resolution_clock::now();
     auto duration = duration_cast<microseconds>(endBeforeSave - start).count();
     cout << "[Performance] addRecord execution time (excluding save): " << duration << " microseconds\n";
+    recordLatency("add", "Linked List", duration);
 
     cout << "\n=== NEW JOB ADDED ===\n";
     cout << "Job ID: " << count << endl;
     cout << "Title: " << tail->title << endl;
     cout << "Description: " << tail->description << endl;
+    if (duplicates) duplicates->reportDuplicates(tail->jobID, "Job");
 
     if (confirmAction("A new job record has been added to the list.")) {
         if (!csvFilename.empty()) saveToCSV(csvFilename);
@@ -175,6 +213,26 @@ void JobLinkedList::addRecord() {
     }
 }
 
+// ---------------- removeAt ----------------
+bool JobLinkedList::removeAt(int position) {
+    if (position < 1 || position > count) return false;
+
+    JobNode *prev = nullptr;
+    JobNode *curr = head;
+    for (int i = 1; i < position; i++) {
+        prev = curr;
+        curr = curr->next;
+    }
+
+    notifyRemove(curr);
+    if (prev) prev->next = curr->next;
+    else head = curr->next;
+    if (curr == tail) tail = prev;
+    delete curr;
+    count--;
+    return true;
+}
+
 // ---------------- deleteFromHead ----------------
 void JobLinkedList::deleteFromHead() {
     auto start = high_resolution_clock::now();
@@ -184,16 +242,13 @@ void JobLinkedList::deleteFromHead() {
         return;
     }
 
-    JobNode *temp = head;
-    cout << "\nDeleting Job ID " << temp->jobID << " (Head)\n";
-    head = head->next;
-    if (!head) tail = nullptr;
-    delete temp;
-    count--;
+    cout << "\nDeleting Job ID " << head->jobID << " (Head)\n";
+    removeAt(1);
 
     auto endBeforeSave = high_resolution_clock::now();
     auto duration = duration_cast<microseconds>(endBeforeSave - start).count();
     cout << "[Performance] deleteFromHead execution time (excluding save): " << duration << " microseconds\n";
+    recordLatency("delete", "Linked List", duration);
 
     if (confirmAction("Head job record deleted.")) {
         if (!csvFilename.empty()) saveToCSV(csvFilename);
@@ -209,22 +264,12 @@ void JobLinkedList::deleteFromTail() {
         return;
     }
 
-    if (head == tail) {
-        delete head;
-        head = tail = nullptr;
-        count--;
-    } else {
-        JobNode *curr = head;
-        while (curr->next != tail) curr = curr->next;
-        delete tail;
-        tail = curr;
-        tail->next = nullptr;
-        count--;
-    }
+    removeAt(count);
 
     auto endBeforeSave = high_resolution_clock::now();
     auto duration = duration_cast<microseconds>(endBeforeSave - start).count();
     cout << "[Performance] deleteFromTail execution time (excluding save): " << duration << " microseconds\n";
+    recordLatency("delete", "Linked List", duration);
 
     if (confirmAction("Tail job record deleted.")) {
         if (!csvFilename.empty()) saveToCSV(csvFilename);
@@ -249,20 +294,12 @@ void JobLinkedList::deleteFromMiddle(int position) {
         return;
     }
 
-    JobNode *curr = head;
-    JobNode *prev = nullptr;
-    for (int i = 1; i < position; i++) {
-        prev = curr;
-        curr = curr->next;
-    }
-
-    prev->next = curr->next;
-    delete curr;
-    count--;
+    removeAt(position);
 
     auto endBeforeSave = high_resolution_clock::now();
     auto duration = duration_cast<microseconds>(endBeforeSave - start).count();
     cout << "[Performance] deleteFromMiddle execution time (excluding save): " << duration << " microseconds\n";
+    recordLatency("delete", "Linked List", duration);
 
     if (confirmAction("Middle job record deleted.")) {
         if (!csvFilename.empty()) saveToCSV(csvFilename);
@@ -280,6 +317,7 @@ bool JobLinkedList::confirmAction(const string &message) {
 }
 
 void JobLinkedList::clear() {
+    detachListeners();
     while (head) {
         JobNode *tmp = head;
         head = head->next;
@@ -290,20 +328,26 @@ void JobLinkedList::clear() {
 }
 
 void JobLinkedList::saveToCSV(const string &filename) const {
-    ofstream file(filename);
-    if (!file.is_open()) {
-        cerr << "Error: Unable to open " << filename << endl;
-        return;
-    }
+    TRACE_SCOPE("saveToCSV [Job Linked List]");
+    auto start = high_resolution_clock::now();
 
+    string content;
     JobNode* current = head;
     while (current != nullptr) {
-        file << current->jobID << "," << current->description << "\n";
+        content += to_string(current->jobID);
+        content += ',';
+        current->description.appendTo(content);
+        content += '\n';
         current = current->next;
     }
+    long long generation = SnapshotWriter::instance().submit(filename, std::move(content));
+    cout << "[Info] Jobs queued for " << filename << " (generation " << generation << ")\n";
 
-    file.close();
-    cout << "[Info] Jobs saved to " << filename << endl;
+    auto end = high_resolution_clock::now();
+    cout << "[Performance] saveToCSV execution time: "
+         << duration_cast<microseconds>(end - start).count()
+         << " microseconds\n";
+    recordLatency("save", "Linked List", duration_cast<microseconds>(end - start).count());
 }
 
 // Find job node by ID
@@ -319,3 +363,153 @@ JobNode* JobLinkedList::findJobByID(int id) const {
 
 int JobLinkedList::size() const { return count; }
 JobNode *JobLinkedList::getHead() const { return head; }
+
+// ---------------- bulkImport ----------------
+int JobLinkedList::bulkImport(const string &filename) {
+    ifstream file(filename);
+    if (!file.is_open()) {
+        cout << "Error: Cannot open " << filename << endl;
+        return 0;
+    }
+    return bulkImport(file);
+}
+
+int JobLinkedList::bulkImport(istream &in) {
+    TRACE_SCOPE("bulkImport [Job Linked List]");
+    auto start = high_resolution_clock::now();
+
+    vector<string> lines;
+    {
+        MemoryScope scope(MEMORY_STORE, MemoryAccounting::DESCRIPTIONS);
+        readImportLines(in, "job_description", lines);
+    }
+    int added = (int)lines.size();
+    if (added == 0) {
+        cout << "No jobs to import.\n";
+        return 0;
+    }
+
+    // Nodes are built off to the side and linked in only once they are complete
+    vector<JobNode*> batch(added);
+    int firstID = tail ? tail->jobID + 1 : 1;
+    {
+        MemoryScope scope(MEMORY_STORE, MemoryAccounting::NODES);
+        for (int i = 0; i < added; ++i) {
+            batch[i] = new JobNode();
+            batch[i]->jobID = firstID + i;
+            batch[i]->description = std::move(lines[i]);   // keeps its DESCRIPTIONS tag
+            batch[i]->next = nullptr;
+        }
+    }
+
+    JobNode **nodes = batch.data();
+    parallelChunks(added, "import worker", [nodes](int begin, int end) {
+        MemoryScope scope(MEMORY_STORE, MemoryAccounting::KEYWORDS);
+        for (int i = begin; i < end; ++i) extractInfo(nodes[i]);
+    });
+
+    for (int i = 0; i + 1 < added; ++i) batch[i]->next = batch[i + 1];
+    if (!head) head = batch[0];
+    else tail->next = batch[0];
+    tail = batch[added - 1];
+    count += added;
+
+    {
+        MemoryScope scope(MEMORY_STORE, MemoryAccounting::INDEXES);
+        for (int i = 0; i < added; ++i) notifyInsert(batch[i]);
+        for (size_t i = 0; i < listeners.size(); ++i) listeners[i]->onBatchEnd();
+    }
+    parallelChunks(added, "import worker", [nodes](int begin, int end) {
+        MemoryScope scope(MEMORY_STORE, MemoryAccounting::DESCRIPTIONS);
+        for (int i = begin; i < end; ++i) nodes[i]->description.pack();
+    });
+
+    auto end = high_resolution_clock::now();
+    reportBulkImport("Job Linked List", "Linked List", added, duration_cast<microseconds>(end - start).count());
+
+    if (!csvFilename.empty()) saveToCSV(csvFilename);
+    else cout << "Warning: No CSV filename stored.\n";
+    return added;
+}
+
+// ---------------- removeWhere ----------------
+int JobLinkedList::removeWhere(const RecordPredicate &predicate) {
+    TRACE_SCOPE("removeWhere [Job Linked List]");
+    auto start = high_resolution_clock::now();
+
+    // One traversal: matching nodes are unlinked behind the last kept node
+    int removed = 0;
+    JobNode *prev = nullptr;
+    JobNode *curr = head;
+    while (curr) {
+        JobNode *next = curr->next;
+        if (predicate.matches(curr->jobID, curr->title, curr->description, curr->keywords)) {
+            notifyRemove(curr);
+            if (prev) prev->next = next;
+            else head = next;
+            delete curr;
+            removed++;
+        } else {
+            prev = curr;
+        }
+        curr = next;
+    }
+    tail = prev;
+    count -= removed;
+    if (removed > 0)
+        for (size_t i = 0; i < listeners.size(); ++i) listeners[i]->onBatchEnd();
+
+    auto end = high_resolution_clock::now();
+    reportBulkDelete("Job Linked List", "Linked List", predicate, removed, count,
+                     duration_cast<microseconds>(end - start).count());
+
+    if (removed > 0) {
+        if (!csvFilename.empty()) saveToCSV(csvFilename);
+        else cout << "Warning: No CSV filename stored.\n";
+    }
+    return removed;
+}
+
+// ---------------- listeners ----------------
+void JobLinkedList::addListener(RecordListener *listener) {
+    listeners.push_back(listener);
+    for (JobNode *curr = head; curr; curr = curr->next)
+        listener->onInsert(curr->jobID, curr->title, curr->description.str(), curr->keywords);
+}
+
+void JobLinkedList::reextractKeywords() {
+    TRACE_SCOPE("reextractKeywords");
+    {
+        MemoryScope scope(MEMORY_STORE, MemoryAccounting::INDEXES);
+        detachListeners();   // shared listeners must see the old keywords go
+    }
+    {
+        MemoryScope scope(MEMORY_STORE, MemoryAccounting::KEYWORDS);
+        for (JobNode *curr = head; curr; curr = curr->next) extractInfo(curr);
+    }
+    MemoryScope scope(MEMORY_STORE, MemoryAccounting::INDEXES);
+    for (JobNode *curr = head; curr; curr = curr->next) notifyInsert(curr);
+    for (size_t i = 0; i < listeners.size(); ++i) listeners[i]->onBatchEnd();
+}
+
+void JobLinkedList::detachListeners() {
+    for (size_t l = 0; l < listeners.size(); ++l) {
+        if (!listeners[l]->sharedBetweenStores()) {
+            listeners[l]->onClear();
+            continue;
+        }
+        for (JobNode *curr = head; curr; curr = curr->next)
+            listeners[l]->onRemove(curr->jobID, curr->title, curr->description.str(), curr->keywords);
+    }
+}
+
+void JobLinkedList::notifyInsert(const JobNode *node) {
+    TRACE_SCOPE("notifyListeners");
+    for (size_t i = 0; i < listeners.size(); ++i)
+        listeners[i]->onInsert(node->jobID, node->title, node->description.str(), node->keywords);
+}
+
+void JobLinkedList::notifyRemove(const JobNode *node) {
+    for (size_t i = 0; i < listeners.size(); ++i)
+        listeners[i]->onRemove(node->jobID, node->title, node->description.str(), node->keywords);
+}
@@ -2,22 +2,41 @@
 #define JOB_LINKEDLIST_H
 
 #include <string>
+#include <istream>
+#include <vector>
+#include "record_listener.h"
+#include "record_store.h"
+#include "text_codec.h"
 using namespace std;
 
+class PrefixCompleter;
+class DuplicateDetector;
+class RecordPredicate;
+
 struct JobNode {
     int jobID;                 // auto ID
     string title;              // title before "needed with experience"
-    string description;        // full text
+    PackedText description;    // full text (compressed with --compress)
     string keywords[10];       // max 10 keywords
     JobNode *next;
 };
 
+// Fill title + keywords from the description
+void extractInfo(JobNode *node);
+
 class JobLinkedList {
 private:
     JobNode *head;
     JobNode *tail;
     int count;
     string csvFilename;  // store the CSV filename for saving
+    vector<RecordListener*> listeners;  // indexes kept in sync with the list
+    PrefixCompleter *titleCompleter;    // optional, used by addRecord()
+    DuplicateDetector *duplicates;      // optional, checked by addRecord()
+
+    void notifyInsert(const JobNode *node);
+    void notifyRemove(const JobNode *node);
+    void detachListeners();           // listeners forget every record of this store
 
 public:
     JobLinkedList();
@@ -26,6 +45,11 @@ public:
     void insertAtEnd(const string &desc);  // only description
     void loadFromCSV(const string &filename);
     void saveToCSV(const string &filename) const;  // save current list to CSV
+
+    // Append a whole file/stream of jobs in one batch, saving once at the end
+    int bulkImport(const string &filename);
+    int bulkImport(istream &in);
+
     void clear();
     int size() const;
     JobNode *getHead() const;
@@ -36,7 +60,37 @@ public:
     void deleteFromHead();               // delete first record
     void deleteFromMiddle(int position); // delete from middle (1-based index)
     void deleteFromTail();               // delete last record
+
+    // Silent delete (no output, no prompt, no save) for scripted runs;
+    // listeners are notified. Returns false for an invalid position.
+    bool removeAt(int position);         // 1-based
+
+    // Unlink every job the predicate matches in one traversal, then save once
+    int removeWhere(const RecordPredicate &predicate);
+
     JobNode* findJobByID(int jobID) const;     // find job by ID
+
+    // RecordStore contract (record_store.h)
+    typedef JobNode record_type;
+    typedef NodeIterator<JobNode> const_iterator;
+    static const bool INDEXED_LOOKUP = false;
+    const_iterator begin() const { return const_iterator(head); }
+    const_iterator end() const { return const_iterator(); }
+    const JobNode* findByID(int jobID) const { return findJobByID(jobID); }
+    static const char* backendName() { return "Linked List"; }
+
+    // Register an index/cache to be told about every insert and delete
+    void addListener(RecordListener *listener);
+
+    // Re-extract every record's keywords after the skill ontology is
+    // reloaded, then rebuild the listeners from them
+    void reextractKeywords();
+
+    // Title suggestions offered while typing a new job in addRecord()
+    void setTitleCompleter(PrefixCompleter *completer) { titleCompleter = completer; }
+
+    // Near-duplicate warning printed after addRecord() (detector must also be a listener)
+    void setDuplicateDetector(DuplicateDetector *detector) { duplicates = detector; }
     
     // Helper functions
     bool confirmAction(const string &message);  // ask user confirmation
@@ -2,21 +2,98 @@
 #include <cstdlib>
 #include <string>
 #include <fstream>
+#include <vector>
+#include <chrono>
 #include "job_linkedlist.h"
 #include "resume_linkedlist.h"
 #include "job_array.h"
 #include "resume_array.h"
 #include "utility.h"
 #include "matching.h"
+#include "skill_index.h"
+#include "autocomplete.h"
+#include "fulltext_index.h"
+#include "duplicate_detector.h"
+#include "sharded_resume_store.h"
+#include "benchmark.h"
+#include "metrics.h"
+#include "server.h"
+#include "trace.h"
+#include "memory_accounting.h"
+#include "microbench.h"
+#include "snapshot_writer.h"
+#include "record_filter.h"
+#include "text_codec.h"
+#include "analytics.h"
+#include "query_arena.h"
+#include "query_planner.h"
+#include "skill_ontology.h"
 using namespace std;
 
-int main() {
+// Read operations the planner may route ("3. Auto"), with the latency
+// metrics that measure them (nullptr: timed by the wall clock). Only metrics
+// every completed run records are listed: an optional step the user may
+// decline ("sort" after menu 1, "boolean_execute") would mix full and partial
+// runs into one estimate. Writes keep an explicit choice: the two stores are
+// separate copies, and a write sent to whichever is cheaper would leave the
+// other one silently out of date.
+struct PlannedChoice {
+    int choice;
+    const char *operation;
+    const char *metrics[3];
+};
+
+static const PlannedChoice PLANNED_CHOICES[] = {
+    { 1,  "match_job",       { "match", nullptr } },
+    { 2,  "match_resume",    { "match", "sort", nullptr } },
+    { 3,  "search",          { "search", nullptr } },
+    { 6,  "display_jobs",    { nullptr } },
+    { 7,  "display_resumes", { nullptr } },
+    { 8,  "boolean_search",  { "boolean_search", nullptr } },
+    { 10, "fulltext_search", { "fulltext_search", nullptr } },
+    { 12, "duplicates",      { "duplicate_check", nullptr } },
+    { 14, "rank",            { "rank", nullptr } },
+    { 20, "analytics",       { "analytics", nullptr } },
+    { 21, "threshold",       { "threshold", nullptr } },
+    { 22, "batch_match",     { "batch_match", nullptr } },
+};
+
+static const PlannedChoice* plannedChoice(int choice) {
+    for (size_t i = 0; i < sizeof(PLANNED_CHOICES) / sizeof(PLANNED_CHOICES[0]); ++i)
+        if (PLANNED_CHOICES[i].choice == choice) return &PLANNED_CHOICES[i];
+    return nullptr;
+}
+
+int main(int argc, char *argv[]) {
+    // --trace <file> may appear anywhere; strip it before the mode flags below
+    string traceFile;
+    for (int i = 1; i < argc; ++i) {
+        if (string(argv[i]) != "--trace") continue;
+        traceFile = (i + 1 < argc) ? argv[i + 1] : "trace.json";
+        int used = (i + 1 < argc) ? 2 : 1;
+        for (int j = i; j + used < argc; ++j) argv[j] = argv[j + used];
+        argc -= used;
+        break;
+    }
+    TraceSession trace(traceFile);
+
+    // --compress may also appear anywhere: descriptions are kept packed in memory
+    bool compress = false;
+    for (int i = 1; i < argc; ++i) {
+        if (string(argv[i]) != "--compress") continue;
+        compress = true;
+        for (int j = i; j + 1 < argc; ++j) argv[j] = argv[j + 1];
+        argc--;
+        break;
+    }
+
     cout << "========================================\n";
     cout << "              Loading Job               \n";
     cout << "========================================\n";
 
     string jobFile = "../data/job_description.csv";
     string resumeFile = "../data/resume.csv";
+    string ontologyFile = "../data/skill_ontology.txt";
     string tempFolder = "../data/temp";
 
     string command = "mkdir \"" + tempFolder + "\"";
@@ -35,18 +112,93 @@ int main() {
         return 1;
     }
 
+    if (compress) {
+        auto start = chrono::high_resolution_clock::now();
+        vector<string> samples;
+        samples.push_back(jobCopy);
+        samples.push_back(resumeCopy);
+        if (!TextCodec::trainFromFiles(samples, 5000)) {
+            cout << "Could not train the description dictionary; compression stays off.\n";
+        } else {
+            auto end = chrono::high_resolution_clock::now();
+            cout << "[Performance] Training " << TextCodec::dictionaryEntries() << "-entry description dictionary: "
+                 << chrono::duration_cast<chrono::microseconds>(end - start).count() << " microseconds\n\n";
+        }
+    }
+
+    // Skill synonyms and partial credit, applied as keywords are extracted;
+    // without the file skills match exactly as written
+    if (ifstream(ontologyFile.c_str()).good() && SkillOntology::load(ontologyFile)) {
+        SkillOntology::printReport();
+        cout << "\n";
+    }
+
+    // Scripted run: main --benchmark [output.json]
+    if (argc > 1 && string(argv[1]) == "--benchmark")
+        return runBenchmark(jobCopy, resumeCopy, argc > 2 ? argv[2] : "benchmark.json");
+
+    // Scripted run: main --microbench [options], see microbench.h
+    if (argc > 1 && string(argv[1]) == "--microbench")
+        return runMicrobench(argc, argv, jobCopy, resumeCopy);
+
+    // Indexes follow their containers through every add/delete.
+    // Each data structure gets its own set so the two never disagree.
+    SkillIndex resumeSkillsLinkedList;
+    SkillIndex resumeSkillsArray;
+    PrefixCompleter skillCompleterLinkedList(PrefixCompleter::SKILLS);
+    PrefixCompleter skillCompleterArray(PrefixCompleter::SKILLS);
+    PrefixCompleter titleCompleterLinkedList(PrefixCompleter::TITLES);
+    PrefixCompleter titleCompleterArray(PrefixCompleter::TITLES);
+    FullTextIndex resumeTextLinkedList;
+    FullTextIndex resumeTextArray;
+    DuplicateDetector jobDuplicatesLinkedList;
+    DuplicateDetector jobDuplicatesArray;
+    DuplicateDetector resumeDuplicatesLinkedList;
+    DuplicateDetector resumeDuplicatesArray;
+
     JobLinkedList jobLinkedList;
+    jobLinkedList.addListener(&skillCompleterLinkedList);
+    jobLinkedList.addListener(&titleCompleterLinkedList);
+    jobLinkedList.setTitleCompleter(&titleCompleterLinkedList);
+    jobLinkedList.addListener(&jobDuplicatesLinkedList);
+    jobLinkedList.setDuplicateDetector(&jobDuplicatesLinkedList);
     jobLinkedList.loadFromCSV(jobCopy);
 
     JobArray jobArray;
+    jobArray.addListener(&skillCompleterArray);
+    jobArray.addListener(&titleCompleterArray);
+    jobArray.setTitleCompleter(&titleCompleterArray);
+    jobArray.addListener(&jobDuplicatesArray);
+    jobArray.setDuplicateDetector(&jobDuplicatesArray);
     jobArray.loadFromCSV(jobCopy);
 
     ResumeLinkedList resumeLinkedList;
+    resumeLinkedList.addListener(&resumeSkillsLinkedList);
+    resumeLinkedList.addListener(&skillCompleterLinkedList);
+    resumeLinkedList.addListener(&resumeTextLinkedList);
+    resumeLinkedList.addListener(&resumeDuplicatesLinkedList);
+    resumeLinkedList.setDuplicateDetector(&resumeDuplicatesLinkedList);
     resumeLinkedList.loadFromCSV(resumeCopy);
 
     ResumeArray resumeArray;
+    resumeArray.addListener(&resumeSkillsArray);
+    resumeArray.addListener(&skillCompleterArray);
+    resumeArray.addListener(&resumeTextArray);
+    resumeArray.addListener(&resumeDuplicatesArray);
+    resumeArray.setDuplicateDetector(&resumeDuplicatesArray);
     resumeArray.loadFromCSV(resumeCopy);
 
+    ShardedResumeStore shardedResumes;   // started on first use of menu 13
+
+    resumeSkillsLinkedList.optimize();
+    resumeSkillsArray.optimize();
+
+    // Scripted run: main --serve [metrics.prom] [intervalSeconds]
+    if (argc > 1 && string(argv[1]) == "--serve")
+        return runServer(jobLinkedList, resumeLinkedList, resumeSkillsLinkedList,
+                         jobArray, resumeArray, resumeSkillsArray, resumeCopy,
+                         argc > 2 ? argv[2] : "metrics.prom", argc > 3 ? atoi(argv[3]) : 10);
+
     int choice;
     do {
         cout << "\n========================================\n";
@@ -59,6 +211,22 @@ int main() {
         cout << "5. Delete Record (Job/Resume)\n";
         cout << "6. Display All Jobs\n";
         cout << "7. Display All Resumes\n";
+        cout << "8. Boolean Skill Search (AND / OR / NOT)\n";
+        cout << "9. Autocomplete Skills / Job Titles\n";
+        cout << "10. Full-Text Resume Search (words / \"phrases\")\n";
+        cout << "11. Index Memory Report\n";
+        cout << "12. Near-Duplicate Report (Jobs / Resumes)\n";
+        cout << "13. Sharded Resume Matching (worker processes)\n";
+        cout << "14. Ranked Resume List for a Job (paged)\n";
+        cout << "15. Latency Metrics Report\n";
+        cout << "16. Memory Accounting Report\n";
+        cout << "17. Background Save Status\n";
+        cout << "18. Bulk Import from File (Jobs/Resumes)\n";
+        cout << "19. Bulk Delete by Filter (skill / IDs / text / duplicates)\n";
+        cout << "20. Skill Demand / Supply Analytics\n";
+        cout << "21. Threshold Match (every resume >= X% exact match for a Job)\n";
+        cout << "22. All-vs-All Top 3 (batched SIMD bitset scoring)\n";
+        cout << "23. Reload Skill Ontology (synonyms / partial credit)\n";
         cout << "0. Exit\n";
         cout << "========================================\n";
         cout << "Enter choice: ";
@@ -71,29 +239,40 @@ int main() {
             continue;
         }
 
-        if (choice >= 1 && choice <= 7) {
+        if ((choice >= 1 && choice <= 12) || choice == 14 || choice == 18 || choice == 19 || choice == 20 || choice == 21 || choice == 22) {
+            const PlannedChoice *planned = plannedChoice(choice);
             int dataChoice;
-            cout << "\nUse Data Structure:\n1. Linked List\n2. Array\nChoose: ";
+            cout << "\nUse Data Structure:\n1. Linked List\n2. Array\n";
+            if (planned) cout << "3. Auto (cost-based planner)\n";
+            cout << "Choose: ";
             cin >> dataChoice;
 
-            if (cin.fail() || (dataChoice != 1 && dataChoice != 2)) {
+            if (cin.fail() || (dataChoice != 1 && dataChoice != 2 && !(planned && dataChoice == 3))) {
                 cin.clear();
                 cin.ignore(10000, '\n');
                 cout << "Invalid selection.\n";
                 continue;
             }
 
+            // Auto: the planner picks the backend now and learns the actual cost below
+            PlannedQuery *plan = nullptr;
+            if (dataChoice == 3) {
+                const char *const *metrics = planned->metrics[0] ? planned->metrics : nullptr;
+                plan = new PlannedQuery(planned->operation, metrics, true);
+                dataChoice = plan->backend() + 1;
+            }
+
             switch (choice) {
                 case 1: {
                     int jobID;
                     if (dataChoice == 1) {
                         cout << "\nEnter Job ID (1 to " << jobLinkedList.size() << "): ";
                         cin >> jobID;
-                        Matcher::matchTop3ForJobLinkedList(jobID, jobLinkedList, resumeLinkedList);
+                        Matcher::matchTop3ForJob(jobID, jobLinkedList, resumeLinkedList);
                     } else {
-                        cout << "\nEnter Job ID (1 to " << jobArray.getSize() << "): ";
+                        cout << "\nEnter Job ID (1 to " << jobArray.size() << "): ";
                         cin >> jobID;
-                        Matcher::matchTop3ForJobArray(jobID - 1, jobArray, resumeArray);
+                        Matcher::matchTop3ForJob(jobID, jobArray, resumeArray);
                     }
                     break;
                 }
@@ -103,20 +282,20 @@ int main() {
                     if (dataChoice == 1) {
                         cout << "\nEnter Resume ID (1 to " << resumeLinkedList.size() << "): ";
                         cin >> resumeID;
-                        Matcher::matchTop3ForResumeLinkedList(resumeID, jobLinkedList, resumeLinkedList);
+                        Matcher::matchTop3ForResume(resumeID, jobLinkedList, resumeLinkedList);
                     } else {
                         cout << "\nEnter Resume ID (1 to " << resumeArray.size() << "): ";
                         cin >> resumeID;
-                        Matcher::matchTop3ForResumeArray(resumeID - 1, jobArray, resumeArray);
+                        Matcher::matchTop3ForResume(resumeID, jobArray, resumeArray);
                     }
                     break;
                 }
 
                 case 3: {
                     if (dataChoice == 1)
-                        Matcher::searchByKeywordLinkedList(resumeLinkedList);
+                        Matcher::searchByKeyword(resumeLinkedList, &skillCompleterLinkedList);
                     else
-                        Matcher::searchByKeywordArray(resumeArray);
+                        Matcher::searchByKeyword(resumeArray, &skillCompleterArray);
                     break;
                 }
 
@@ -187,8 +366,296 @@ int main() {
                     else resumeArray.display();
                     break;
                 }
+
+                case 8: {
+                    if (dataChoice == 1)
+                        Matcher::booleanSearch(resumeLinkedList, resumeSkillsLinkedList);
+                    else
+                        Matcher::booleanSearch(resumeArray, resumeSkillsArray);
+                    break;
+                }
+
+                case 9: {
+                    int type;
+                    cout << "\nComplete:\n1. Skills\n2. Job Titles\nChoose type: ";
+                    cin >> type;
+                    cin.ignore(10000, '\n');
+
+                    PrefixCompleter *completer;
+                    if (type == 2) completer = (dataChoice == 1) ? &titleCompleterLinkedList : &titleCompleterArray;
+                    else completer = (dataChoice == 1) ? &skillCompleterLinkedList : &skillCompleterArray;
+
+                    string prefix;
+                    while (true) {
+                        cout << "\nType a prefix (empty line to stop): ";
+                        if (!getline(cin, prefix) || prefix.empty()) break;
+
+                        auto start = chrono::high_resolution_clock::now();
+                        vector<Completion> options = completer->complete(prefix);
+                        auto end = chrono::high_resolution_clock::now();
+
+                        if (options.empty()) cout << "(no completions)\n";
+                        for (size_t i = 0; i < options.size(); ++i)
+                            cout << "  " << options[i].text << " (" << options[i].frequency << ")\n";
+                        cout << "[Performance] autocomplete lookup: "
+                             << chrono::duration_cast<chrono::nanoseconds>(end - start).count()
+                             << " nanoseconds\n";
+                    }
+                    break;
+                }
+
+                case 10: {
+                    if (dataChoice == 1)
+                        Matcher::fullTextSearch(resumeLinkedList, resumeTextLinkedList);
+                    else
+                        Matcher::fullTextSearch(resumeArray, resumeTextArray);
+                    cout << "[Memory] full-text index: " << (dataChoice == 1 ? resumeTextLinkedList : resumeTextArray).memoryBytes() / 1024
+                         << " KB for " << (dataChoice == 1 ? resumeTextLinkedList : resumeTextArray).termCount() << " terms\n";
+                    break;
+                }
+
+                case 11: {
+                    SkillIndex &skills = (dataChoice == 1) ? resumeSkillsLinkedList : resumeSkillsArray;
+                    FullTextIndex &text = (dataChoice == 1) ? resumeTextLinkedList : resumeTextArray;
+                    const char *label = (dataChoice == 1) ? "Linked List" : "Array";
+                    skills.optimize();
+                    skills.printMemoryReport(label);
+                    cout << "[Memory] full-text index [" << label << "]: " << text.memoryBytes()
+                         << " bytes for " << text.termCount() << " terms\n";
+                    break;
+                }
+
+                case 12: {
+                    int type;
+                    cout << "\nCheck:\n1. Jobs\n2. Resumes\nChoose type: ";
+                    cin >> type;
+
+                    DuplicateDetector *detector;
+                    if (type == 1) detector = (dataChoice == 1) ? &jobDuplicatesLinkedList : &jobDuplicatesArray;
+                    else detector = (dataChoice == 1) ? &resumeDuplicatesLinkedList : &resumeDuplicatesArray;
+                    const char *recordType = (type == 1) ? "Job" : "Resume";
+
+                    auto start = chrono::high_resolution_clock::now();
+                    vector<vector<int> > clusters = detector->findClusters();
+                    auto end = chrono::high_resolution_clock::now();
+
+                    size_t covered = 0;
+                    for (size_t i = 0; i < clusters.size(); ++i) covered += clusters[i].size();
+                    cout << "\n" << clusters.size() << " duplicate clusters covering " << covered
+                         << " of " << detector->recordCount() << " " << recordType << " records\n";
+
+                    for (size_t i = 0; i < clusters.size() && i < 10; ++i) {
+                        cout << "  " << clusters[i].size() << " records: ";
+                        for (size_t k = 0; k < clusters[i].size() && k < 8; ++k)
+                            cout << recordType << " [" << clusters[i][k] << "] ";
+                        if (clusters[i].size() > 8) cout << "...";
+                        cout << "\n";
+                    }
+                    cout << "[Performance] duplicate clustering execution time: "
+                         << chrono::duration_cast<chrono::microseconds>(end - start).count() << " microseconds\n";
+                    cout << "[Memory] duplicate detector: " << detector->memoryBytes() / 1024 << " KB\n";
+                    break;
+                }
+
+                case 14: {
+                    int jobID;
+                    if (dataChoice == 1) {
+                        cout << "\nEnter Job ID (1 to " << jobLinkedList.size() << "): ";
+                        cin >> jobID;
+                        Matcher::rankedResumesForJob(jobID, jobLinkedList, resumeLinkedList);
+                    } else {
+                        cout << "\nEnter Job ID (1 to " << jobArray.size() << "): ";
+                        cin >> jobID;
+                        Matcher::rankedResumesForJob(jobID, jobArray, resumeArray);
+                    }
+                    break;
+                }
+
+                case 18: {
+                    int type;
+                    string path;
+                    cout << "\nImport:\n1. Jobs\n2. Resumes\nChoose type: ";
+                    cin >> type;
+                    cin.ignore(10000, '\n');
+                    cout << "Enter file to import (CSV export or one description per line): ";
+                    getline(cin, path);
+
+                    if (dataChoice == 1) {
+                        if (type == 1) jobLinkedList.bulkImport(path);
+                        else if (type == 2) resumeLinkedList.bulkImport(path);
+                    } else {
+                        if (type == 1) jobArray.bulkImport(path);
+                        else if (type == 2) resumeArray.bulkImport(path);
+                    }
+                    break;
+                }
+
+                case 19: {
+                    int type, filter;
+                    cout << "\nDelete from:\n1. Jobs\n2. Resumes\nChoose type: ";
+                    cin >> type;
+                    cout << "\nDelete every record that:\n1. Lists a skill\n2. Has one of these IDs\n"
+                         << "3. Contains text in its description\n4. Is a near-duplicate of an older record\nChoose: ";
+                    cin >> filter;
+                    cin.ignore(10000, '\n');
+                    if (cin.fail() || (type != 1 && type != 2) || filter < 1 || filter > 4) {
+                        cin.clear();
+                        cout << "Invalid selection.\n";
+                        break;
+                    }
+
+                    static const char *kinds[] = { "skill", "ids", "text", "duplicates" };
+                    static const char *prompts[] = { "Enter skill: ", "Enter IDs (e.g. 3,7,100-250): ", "Enter text: " };
+                    string argument;
+                    if (filter < 4) {
+                        cout << prompts[filter - 1];
+                        getline(cin, argument);
+                    }
+
+                    DuplicateDetector *detector;
+                    if (dataChoice == 1) detector = (type == 1) ? &jobDuplicatesLinkedList : &resumeDuplicatesLinkedList;
+                    else detector = (type == 1) ? &jobDuplicatesArray : &resumeDuplicatesArray;
+
+                    RecordPredicate *predicate = makePredicate(kinds[filter - 1], argument, detector);
+                    if (!predicate) break;
+                    if (dataChoice == 1) {
+                        if (type == 1) jobLinkedList.removeWhere(*predicate);
+                        else resumeLinkedList.removeWhere(*predicate);
+                    } else {
+                        if (type == 1) jobArray.removeWhere(*predicate);
+                        else resumeArray.removeWhere(*predicate);
+                    }
+                    delete predicate;
+                    break;
+                }
+
+                case 20: {
+                    SkillAnalytics analytics = (dataChoice == 1)
+                        ? computeSkillAnalytics(jobLinkedList, resumeLinkedList)
+                        : computeSkillAnalytics(jobArray, resumeArray);
+                    analytics.printSummary(10);
+                    cout << "[Performance] Skill analytics (" << analytics.workers << " threads): "
+                         << analytics.micros << " microseconds\n";
+                    if (analytics.writeCSV("skill_analytics.csv"))
+                        cout << "Per-title table written to skill_analytics.csv\n";
+
+                    string title, skill;
+                    cin.ignore(10000, '\n');
+                    cout << "\nLook up a job title (blank to skip): ";
+                    getline(cin, title);
+                    if (title.empty()) break;
+                    cout << "Skill: ";
+                    getline(cin, skill);
+                    analytics.printLookup(title, skill);
+                    break;
+                }
+
+                case 21: {
+                    int jobID;
+                    if (dataChoice == 1) {
+                        cout << "\nEnter Job ID (1 to " << jobLinkedList.size() << "): ";
+                        cin >> jobID;
+                        Matcher::thresholdMatchForJob(jobID, jobLinkedList, resumeLinkedList, resumeSkillsLinkedList);
+                    } else {
+                        cout << "\nEnter Job ID (1 to " << jobArray.size() << "): ";
+                        cin >> jobID;
+                        Matcher::thresholdMatchForJob(jobID, jobArray, resumeArray, resumeSkillsArray);
+                    }
+                    break;
+                }
+
+                case 22: {
+                    if (dataChoice == 1) Matcher::matchAllJobsBatched(jobLinkedList, resumeLinkedList);
+                    else Matcher::matchAllJobsBatched(jobArray, resumeArray);
+                    break;
+                }
+            }
+            delete plan;
+        } else if (choice == 13) {
+            // Resumes are partitioned from the array store on first use
+            if (!shardedResumes.isRunning()) {
+                int shardCount;
+                cout << "\nNumber of shards: ";
+                cin >> shardCount;
+                if (cin.fail() || shardCount < 1) {
+                    cin.clear();
+                    cin.ignore(10000, '\n');
+                    cout << "Invalid shard count.\n";
+                    continue;
+                }
+                auto start = chrono::high_resolution_clock::now();
+                if (!shardedResumes.start(shardCount, resumeArray)) continue;
+                auto end = chrono::high_resolution_clock::now();
+                cout << "[Performance] Starting " << shardCount << " shard workers: "
+                     << chrono::duration_cast<chrono::microseconds>(end - start).count() << " microseconds\n";
             }
+
+            int action;
+            cout << "\nSharded:\n1. Match Top 3 Resumes for a Job\n2. Add Resume\n3. Delete Resume by ID\n4. Shard Sizes\nChoose: ";
+            cin >> action;
+            cin.ignore(10000, '\n');
+
+            if (action == 1) {
+                int jobID;
+                cout << "\nEnter Job ID (1 to " << jobArray.size() << "): ";
+                cin >> jobID;
+                Matcher::matchTop3ForJobSharded(jobID, jobArray, shardedResumes);
+            } else if (action == 2) {
+                string skills;
+                cout << "Enter your skills (comma-separated, e.g., Python, Java, SQL): ";
+                getline(cin, skills);
+                int id = shardedResumes.add("Experienced professional skilled in " + skills + ".");
+                cout << "Added Resume [" << id << "].\n";
+            } else if (action == 3) {
+                int id;
+                cout << "Enter Resume ID: ";
+                cin >> id;
+                cout << (shardedResumes.remove(id) ? "Deleted.\n" : "Resume not found.\n");
+            } else if (action == 4) {
+                vector<int> sizes = shardedResumes.shardSizes();
+                for (size_t s = 0; s < sizes.size(); ++s)
+                    cout << "  Shard " << s << ": " << sizes[s] << " resumes\n";
+            }
+        } else if (choice == 15) {
+            cout << "\n=== Latency Metrics ===\n";
+            MetricsRegistry::instance().printSummary();
+            if (MetricsRegistry::instance().dumpToFile("metrics.prom"))
+                cout << "Prometheus metrics written to metrics.prom\n";
+            QueryPlanner::instance().printReport();
+        } else if (choice == 16) {
+            cout << "\n=== Memory Accounting ===\n";
+            MemoryAccounting::printReport();
+            TextCodec::printReport();
+            QueryArena::printReport();
+            cout << "Records: " << jobLinkedList.size() << " jobs (linked list), " << jobArray.size()
+                 << " jobs (array), " << resumeLinkedList.size() << " resumes (linked list), "
+                 << resumeArray.size() << " resumes (array)\n";
+        } else if (choice == 17) {
+            cout << "\n=== Background Saves ===\n";
+            SnapshotWriter::instance().printStatus();
+        } else if (choice == 23) {
+            string file;
+            cout << "\nOntology file (Enter for " << ontologyFile << "): ";
+            cin.ignore(10000, '\n');
+            getline(cin, file);
+            if (file.empty()) file = ontologyFile;
+            if (!SkillOntology::load(file)) continue;
+
+            // Both structures are re-extracted so they keep matching each other
+            auto start = chrono::high_resolution_clock::now();
+            jobLinkedList.reextractKeywords();
+            jobArray.reextractKeywords();
+            resumeLinkedList.reextractKeywords();
+            resumeArray.reextractKeywords();
+            auto end = chrono::high_resolution_clock::now();
+            SkillOntology::printReport();
+            cout << "[Performance] Re-extracting keywords (both structures): "
+                 << chrono::duration_cast<chrono::microseconds>(end - start).count() << " microseconds\n";
+            if (shardedResumes.isRunning() && !shardedResumes.reloadOntology())
+                cout << "Warning: a shard worker could not load " << file << ".\n";
         } else if (choice == 0) {
+            // Edits never waited for the disk; the last snapshots must land before exit
+            SnapshotWriter::instance().flush();
             cout << "\nThank you for using the Job & Resume Matching System!\n";
         } else {
             cout << "Invalid choice. Please try again.\n";
@@ -0,0 +1,159 @@
+#include "match_results.h"
+#include "query_arena.h"
+#include <iostream>
+#include <algorithm>
+using namespace std;
+
+static void printMatch(int rank, const char *kind, int id, double rate, const string *title,
+                       const PackedText *desc) {
+    cout << rank << ". " << kind << " [" << id << "] (" << rate << "%)\n";
+    if (title && !title->empty()) cout << *title << " | ";
+    cout << *desc << "\n";
+}
+
+// ---------------- MatchNodePool ----------------
+MatchNodePool::~MatchNodePool() {
+    for (size_t b = 0; b < blocks.size(); ++b) delete[] blocks[b];
+}
+
+MatchNodePool& MatchNodePool::local() {
+    static thread_local MatchNodePool pool;
+    return pool;
+}
+
+MatchNode* MatchNodePool::acquire() {
+    if (!freeList) {
+        MatchNode *block = new MatchNode[BLOCK_NODES];
+        blocks.push_back(block);
+        for (int i = 0; i < BLOCK_NODES - 1; ++i) block[i].next = &block[i + 1];
+        block[BLOCK_NODES - 1].next = nullptr;
+        freeList = block;
+    }
+    MatchNode *node = freeList;
+    freeList = node->next;
+    node->next = nullptr;
+    return node;
+}
+
+void MatchNodePool::release(MatchNode *first, MatchNode *last) {
+    if (!first) return;
+    last->next = freeList;
+    freeList = first;
+}
+
+// ---------------- MatchList ----------------
+MatchList::MatchList(int) : head(nullptr), tail(nullptr), count(0) {}
+
+MatchList::~MatchList() {
+    MatchNodePool::local().release(head, tail);
+}
+
+void MatchList::append(int id, double rate, const PackedText *desc, const string *title) {
+    MatchNode *newNode = MatchNodePool::local().acquire();
+    newNode->id = id;
+    newNode->rate = rate;
+    newNode->title = title;
+    newNode->desc = desc;
+    if (!head) head = newNode;
+    else tail->next = newNode;
+    tail = newNode;
+    count++;
+}
+
+// Sort the first length nodes of list (descending by rate) and return the
+// new head. Taking from the left run on ties keeps the sort stable.
+MatchNode* MatchList::mergeSort(MatchNode *list, int length) {
+    if (length <= 1) {
+        if (list) list->next = nullptr;
+        return list;
+    }
+    int half = length / 2;
+    MatchNode *middle = list;
+    for (int i = 1; i < half; ++i) middle = middle->next;
+    MatchNode *right = middle->next;
+    middle->next = nullptr;
+
+    MatchNode *a = mergeSort(list, half);
+    MatchNode *b = mergeSort(right, length - half);
+    MatchNode merged;
+    MatchNode *last = &merged;
+    while (a && b) {
+        if (a->rate >= b->rate) { last->next = a; a = a->next; }
+        else { last->next = b; b = b->next; }
+        last = last->next;
+    }
+    last->next = a ? a : b;
+    return merged.next;
+}
+
+void MatchList::sortDescending() {
+    if (count < 2) return;
+    head = mergeSort(head, count);
+    tail = head;
+    while (tail->next) tail = tail->next;
+}
+
+void MatchList::printAll(const char *kind) const {
+    printTop(count, kind);
+}
+
+void MatchList::printTop(int n, const char *kind) const {
+    int rank = 0;
+    for (MatchNode *curr = head; curr && rank < n; curr = curr->next) {
+        rank++;
+        printMatch(rank, kind, curr->id, curr->rate, curr->title, curr->desc);
+    }
+}
+
+// ---------------- MatchArray ----------------
+MatchArray::MatchArray(int expected)
+    : count(0), capacity(max(expected, 1)), inArena(QueryArena::local().active()) {
+    matches = allocateMatches(capacity);  // allocate enough for the whole scan up front
+}
+
+MatchArray::~MatchArray() {
+    if (!inArena) delete[] matches;
+}
+
+MatchArray::Match* MatchArray::allocateMatches(int n) {
+    if (inArena) return QueryArena::local().allocateArray<Match>(n);
+    return new Match[n];
+}
+
+void MatchArray::append(int id, double rate, const PackedText *desc, const string *title) {
+    if (count == capacity) {
+        capacity *= 2;
+        Match *bigger = allocateMatches(capacity);
+        for (int i = 0; i < count; ++i) bigger[i] = matches[i];
+        if (!inArena) delete[] matches;
+        matches = bigger;
+    }
+    matches[count].id = id;
+    matches[count].rate = rate;
+    matches[count].title = title;
+    matches[count].desc = desc;
+    count++;
+}
+
+// Sort descending by rate (using bubble sort for educational clarity)
+void MatchArray::sortDescending() {
+    for (int i = 0; i < count - 1; ++i) {
+        bool swapped = false;
+        for (int j = 0; j < count - i - 1; ++j) {
+            if (matches[j].rate < matches[j + 1].rate) {
+                swap(matches[j], matches[j + 1]);
+                swapped = true;
+            }
+        }
+        if (!swapped) break; // optional optimization
+    }
+}
+
+void MatchArray::printAll(const char *kind) const {
+    printTop(count, kind);
+}
+
+void MatchArray::printTop(int n, const char *kind) const {
+    for (int t = 0; t < min(n, count); ++t)
+        printMatch(t + 1, kind, matches[t].id, matches[t].rate, matches[t].title, matches[t].desc);
+}
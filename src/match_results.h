@@ -0,0 +1,103 @@
+#ifndef MATCH_RESULTS_H
+#define MATCH_RESULTS_H
+
+#include <string>
+#include <vector>
+#include "text_codec.h"
+using namespace std;
+
+class JobLinkedList;
+class ResumeLinkedList;
+
+// Match results collected while scanning a store. Each backend keeps its
+// results in its own kind of structure so the linked list and array
+// versions stay comparable end to end. Both offer the same operations:
+//   append(id, rate, &desc[, &title]), sortDescending(), printAll(kind), printTop(n, kind)
+// A result holds only the ID, the rate and pointers to the record's own
+// description and title, so scoring N records copies no text; desc is
+// decoded (see text_codec.h) only when a result is printed, and a title,
+// when given, is printed in front of it as "title | desc". The records must
+// stay in the store, unchanged, while the results are in use.
+
+struct MatchNode {
+    int id;
+    double rate;
+    const string *title;       // nullptr when the record has none
+    const PackedText *desc;    // points into the store, not copied
+    MatchNode *next;
+    MatchNode() : id(0), rate(0), title(nullptr), desc(nullptr), next(nullptr) {}
+};
+
+// Free list of MatchNodes shared by the MatchLists of one thread. Nodes are
+// carved from blocks and handed back a whole list at a time, so once a query
+// has run, the next one of the same size allocates nothing.
+class MatchNodePool {
+private:
+    static const int BLOCK_NODES = 1024;
+    MatchNode *freeList;
+    vector<MatchNode*> blocks;
+
+    MatchNodePool(const MatchNodePool &);              // not copyable
+    MatchNodePool& operator=(const MatchNodePool &);
+
+public:
+    MatchNodePool() : freeList(nullptr) {}
+    ~MatchNodePool();
+
+    static MatchNodePool& local();     // this thread's pool
+
+    MatchNode* acquire();
+    void release(MatchNode *first, MatchNode *last);   // a chain first..last
+    size_t capacity() const { return blocks.size() * BLOCK_NODES; }
+};
+
+// Singly linked list of matches with a tail pointer (O(1) append), merge
+// sorted by relinking nodes; the payloads never move
+class MatchList {
+private:
+    MatchNode *head;
+    MatchNode *tail;
+    int count;
+
+    static MatchNode* mergeSort(MatchNode *list, int length);
+
+public:
+    explicit MatchList(int expected = 0);
+    ~MatchList();
+
+    void append(int id, double rate, const PackedText *desc, const string *title = nullptr);
+    void sortDescending();             // stable: equal rates keep scan order
+    int size() const { return count; }
+    void printAll(const char *kind) const;
+    void printTop(int n, const char *kind) const;
+};
+
+// Dynamic array of matches, bubble sorted with an early exit. Inside a
+// QueryScope the array lives in the query arena (query_arena.h).
+class MatchArray {
+private:
+    struct Match { int id; double rate; const string *title; const PackedText *desc; };
+    Match *matches;
+    int count;
+    int capacity;
+    bool inArena;                      // taken from the query's arena: never deleted
+
+    Match* allocateMatches(int n);
+
+public:
+    explicit MatchArray(int expected = 0);
+    ~MatchArray();
+
+    void append(int id, double rate, const PackedText *desc, const string *title = nullptr);
+    void sortDescending();             // stable: equal rates keep scan order
+    int size() const { return count; }
+    void printAll(const char *kind) const;
+    void printTop(int n, const char *kind) const;
+};
+
+// Result structure used when scanning a given store
+template <class Store> struct MatchResultsFor { typedef MatchArray type; };
+template <> struct MatchResultsFor<JobLinkedList> { typedef MatchList type; };
+template <> struct MatchResultsFor<ResumeLinkedList> { typedef MatchList type; };
+
+#endif
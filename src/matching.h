@@ -1,24 +1,528 @@
 #ifndef MATCHING_H
 #define MATCHING_H
 
+#include <iostream>
+#include <chrono>
+#include <cctype>
 #include "job_linkedlist.h"
 #include "resume_linkedlist.h"
 #include "job_array.h"
 #include "resume_array.h"
+#include "skill_index.h"
+#include "autocomplete.h"
+#include "fulltext_index.h"
+#include "sharded_resume_store.h"
+#include "bucket_ranking.h"
+#include "match_results.h"
+#include "boolean_query.h"
+#include "threshold_query.h"
+#include "skill_matrix.h"
+#include "skill_ontology.h"
+#include "utility.h"
+#include "query_arena.h"
+#include "metrics.h"
+#include "trace.h"
 
+// Matching, search and ranking over any store that follows the RecordStore
+// contract (record_store.h). Each algorithm is written once as a template;
+// calling it with a linked list or an array instantiates a specialized copy.
+// Job and resume IDs are the records' own 1-based IDs for every backend.
 class Matcher {
 public:
-    static void matchTop3ForJobLinkedList(int jobID, JobLinkedList &jobs, ResumeLinkedList &resumes);
-    static void matchTop3ForResumeLinkedList(int resumeID, JobLinkedList &jobs, ResumeLinkedList &resumes);
-    static void searchByKeywordLinkedList(ResumeLinkedList &resumes);
+    template <class JobStore, class ResumeStore>
+    static void matchTop3ForJob(int jobID, const JobStore &jobs, const ResumeStore &resumes);
 
-    static void matchTop3ForJobArray(int jobIndex, JobArray &jobs, ResumeArray &resumes);
-    static void matchTop3ForResumeArray(int resumeIndex, JobArray &jobs, ResumeArray &resumes);
-    static void searchByKeywordArray(ResumeArray &resumes);
+    template <class JobStore, class ResumeStore>
+    static void matchTop3ForResume(int resumeID, const JobStore &jobs, const ResumeStore &resumes);
 
-    
-    
+    template <class ResumeStore>
+    static void searchByKeyword(const ResumeStore &resumes, PrefixCompleter *suggestions = nullptr);
 
+    // Boolean skill queries, e.g. Python AND (PyTorch OR TensorFlow) AND NOT Java,
+    // answered from the skill index attached to the given resume container
+    template <class ResumeStore>
+    static void booleanSearch(const ResumeStore &resumes, const SkillIndex &index);
+
+    // Word and "quoted phrase" search over the whole resume text
+    template <class ResumeStore>
+    static void fullTextSearch(const ResumeStore &resumes, const FullTextIndex &index);
+
+    // Every resume ranked for a job by integer score (bucketed, no sort),
+    // browsed page by page with an optional minimum match rate. This screen,
+    // the threshold match and the batched top 3 count exact skill matches
+    // only (no ontology partial credit) and say so in their output.
+    template <class JobStore, class ResumeStore>
+    static void rankedResumesForJob(int jobID, const JobStore &jobs, const ResumeStore &resumes);
+
+    // Every resume with at least a given match rate for a job, streamed in ID
+    // order from the skill index; resumes that cannot qualify are never scored
+    template <class JobStore, class ResumeStore>
+    static void thresholdMatchForJob(int jobID, const JobStore &jobs, const ResumeStore &resumes,
+                                     const SkillIndex &index);
+
+    // The query behind it: writes each qualifying resume to cout as it is
+    // found (with its description when showText) and returns how many
+    template <class ResumeStore>
+    static int streamThresholdMatches(const string jobKeywords[10], double minRate, const ResumeStore &resumes,
+                                      const SkillIndex &index, bool showText, ThresholdQuery::Stats &stats);
+
+    // Top 3 resumes for every job at once, scored as skill bitsets by the
+    // SIMD kernels; the top 3 lists go to batch_top3.csv
+    template <class JobStore, class ResumeStore>
+    static void matchAllJobsBatched(const JobStore &jobs, const ResumeStore &resumes);
+
+    // Top 3 resumes for a job, scored in parallel by the shard workers
+    template <class JobStore>
+    static void matchTop3ForJobSharded(int jobID, const JobStore &jobs, const ShardedResumeStore &store);
+
+    // Number of the job's keywords found (case-insensitively) in the resume
+    static int keywordMatchCount(const string jobKeywords[10], const string resumeKeywords[10]);
+    // Percentage of the job's keywords the resume covers, with partial
+    // credit from the skill ontology for keywords it does not list
+    static double keywordMatchRate(const string jobKeywords[10], const string resumeKeywords[10]);
+    // The same for a job whose ontology lookups were done once up front
+    static double keywordMatchRate(const QuerySkills &job, const string resumeKeywords[10]);
+
+private:
+    static int countKeywords(const string keywords[10]);
+    static void printSuggestions(PrefixCompleter *suggestions, const string &keyword);
+    static BooleanQuery* readBooleanQuery(const SkillIndex &index, const string &label, PostingList &ids, bool &showResults);
+    static bool readFullTextQuery(const FullTextIndex &index, const string &label, PostingList &ids);
+    static void browseRanking(const BucketRanking &ranking);
+
+    template <class ResumeStore>
+    static void printResumesByID(const ResumeStore &resumes, const PostingList &ids);
 };
 
+// Prints threshold matches as the query produces them. IDs arrive ascending,
+// so stores without an ID index are walked forward once.
+template <class ResumeStore>
+class ThresholdPrinter : public ThresholdSink {
+private:
+    const ResumeStore &resumes;
+    const string *jobKeywords;
+    const ThresholdQuery &query;
+    bool rescore;                 // shared counts from the index may be short
+    bool showText;
+    typename ResumeStore::const_iterator cursor;
+
+public:
+    int printed;
+
+    ThresholdPrinter(const ResumeStore &r, const string keywords[10], const ThresholdQuery &q, bool text)
+        : resumes(r), jobKeywords(keywords), query(q), rescore(q.getUnindexed() > 0), showText(text),
+          cursor(r.begin()), printed(0) {}
+
+    void accept(int id, int shared) {
+        const typename ResumeStore::record_type *resume = nullptr;
+        if (ResumeStore::INDEXED_LOOKUP) {
+            resume = resumes.findByID(id);
+        } else {
+            while (cursor != resumes.end() && cursor->resumeID < id) ++cursor;
+            if (cursor != resumes.end() && cursor->resumeID == id) resume = &*cursor;
+        }
+        if (!resume) return;
+        if (rescore) {
+            shared = Matcher::keywordMatchCount(jobKeywords, resume->keywords);
+            if (shared < query.getMinShared()) return;
+        }
+
+        printed++;
+        if (showText)
+            cout << printed << ". Resume [" << id << "] (" << query.rateOf(shared) << "%)\n"
+                 << resume->description << "\n";
+        else
+            cout << " " << id << ":" << query.rateOf(shared);
+    }
+};
+
+// ---------------- template definitions ----------------
+
+template <class JobStore, class ResumeStore>
+void Matcher::matchTop3ForJob(int jobID, const JobStore &jobs, const ResumeStore &resumes) {
+    using namespace std::chrono;
+    TRACE_SCOPE("matchTop3ForJob");
+    QueryScope query(ResumeStore::backendName());   // scratch comes from the warm query arena
+    auto totalStart = high_resolution_clock::now(); // start total timer
+
+    const typename JobStore::record_type *job = jobs.findByID(jobID);
+    if (!job) {
+        cout << "Job ID " << jobID << " not found.\n";
+        return;
+    }
+
+    cout << "\n=== Matching Resumes for Job [" << jobID << "] [" << ResumeStore::backendName() << "] ===\n";
+    int jobKeywordCount = countKeywords(job->keywords);
+    if (jobKeywordCount == 0) {
+        cout << "No keywords found for this job.\n";
+        return;
+    }
+
+    // Measure performance for unsorted matching
+    auto unsortedStart = high_resolution_clock::now();
+
+    typename MatchResultsFor<ResumeStore>::type matches(resumes.size());
+    {
+        TRACE_SCOPE("score");
+        QuerySkills skills(job->keywords);
+        for (typename ResumeStore::const_iterator resume = resumes.begin(); resume != resumes.end(); ++resume) {
+            double rate = skills.credit(resume->keywords) / jobKeywordCount * 100.0;
+            matches.append(resume->resumeID, rate, &resume->description);
+        }
+    }
+
+    auto unsortedEnd = high_resolution_clock::now();
+
+    cout << "\n=== Unsorted Match Results ===\n";
+    {
+        TRACE_SCOPE("printUnsorted");
+        matches.printAll("Resume");
+    }
+    cout << "[Performance] Matching (Unsorted) execution time: "
+         << duration_cast<microseconds>(unsortedEnd - unsortedStart).count()
+         << " microseconds\n";
+    recordLatency("match", ResumeStore::backendName(), duration_cast<microseconds>(unsortedEnd - unsortedStart).count());
+
+    // Ask if user wants sorted results
+    char sortChoice;
+    cout << "\nWould you like to view the sorted top 3 resumes? (y/n): ";
+    cin >> sortChoice;
+
+    if (tolower(sortChoice) == 'y') {
+        auto sortStart = high_resolution_clock::now();
+        {
+            TRACE_SCOPE("sort");
+            matches.sortDescending();
+        }
+        auto sortEnd = high_resolution_clock::now();
+
+        cout << "\n=== Top 3 Sorted Matches ===\n";
+        TRACE_SCOPE("printTop");
+        matches.printTop(3, "Resume");
+
+        cout << "[Sorting Performance] (" << ResumeStore::backendName() << "): "
+             << duration_cast<microseconds>(sortEnd - sortStart).count()
+             << " microseconds\n";
+        recordLatency("sort", ResumeStore::backendName(), duration_cast<microseconds>(sortEnd - sortStart).count());
+    }
+
+    auto totalEnd = high_resolution_clock::now();
+    cout << "[Total Performance] (" << ResumeStore::backendName() << " Matching + Optional Sorting): "
+         << duration_cast<microseconds>(totalEnd - totalStart).count()
+         << " microseconds\n";
+}
+
+template <class JobStore, class ResumeStore>
+void Matcher::matchTop3ForResume(int resumeID, const JobStore &jobs, const ResumeStore &resumes) {
+    using namespace std::chrono;
+    TRACE_SCOPE("matchTop3ForResume");
+    QueryScope query(JobStore::backendName());
+    auto totalStart = high_resolution_clock::now();
+
+    const typename ResumeStore::record_type *resume = resumes.findByID(resumeID);
+    if (!resume) {
+        cout << "Resume ID " << resumeID << " not found.\n";
+        return;
+    }
+
+    cout << "\n=== Matching Jobs for Resume [" << resumeID << "] [" << JobStore::backendName() << "] ===\n";
+    cout << "Resume Description:\n" << resume->description << "\n\n";
+
+    auto matchStart = high_resolution_clock::now();
+
+    typename MatchResultsFor<JobStore>::type matches(jobs.size());
+    {
+        TRACE_SCOPE("score");
+        for (typename JobStore::const_iterator job = jobs.begin(); job != jobs.end(); ++job) {
+            QuerySkills skills(job->keywords);
+            if (skills.size() == 0) continue;
+
+            double rate = skills.credit(resume->keywords) / skills.size() * 100.0;
+            matches.append(job->jobID, rate, &job->description, &job->title);
+        }
+    }
+
+    auto matchEnd = high_resolution_clock::now();
+    auto sortStart = high_resolution_clock::now();
+    {
+        TRACE_SCOPE("sort");
+        matches.sortDescending();
+    }
+    auto sortEnd = high_resolution_clock::now();
+
+    cout << "\n=== Top 3 Sorted Job Matches ===\n";
+    {
+        TRACE_SCOPE("printTop");
+        matches.printTop(3, "Job");
+    }
+
+    cout << "[Performance] Matching (" << JobStore::backendName() << "): "
+         << duration_cast<microseconds>(matchEnd - matchStart).count() << " microseconds\n";
+    cout << "[Sorting Performance] (" << JobStore::backendName() << "): "
+         << duration_cast<microseconds>(sortEnd - sortStart).count() << " microseconds\n";
+    recordLatency("match", JobStore::backendName(), duration_cast<microseconds>(matchEnd - matchStart).count());
+    recordLatency("sort", JobStore::backendName(), duration_cast<microseconds>(sortEnd - sortStart).count());
+
+    auto totalEnd = high_resolution_clock::now();
+    cout << "[Total Performance]: "
+         << duration_cast<microseconds>(totalEnd - totalStart).count() << " microseconds\n";
+}
+
+template <class ResumeStore>
+void Matcher::searchByKeyword(const ResumeStore &resumes, PrefixCompleter *suggestions) {
+    using namespace std::chrono;
+    string keyword;
+    cout << "\nEnter a keyword to search resumes: ";
+    cin.ignore();
+    getline(cin, keyword);
+    keyword = SkillOntology::canonical(keyword);   // once per query, not per resume
+
+    TRACE_SCOPE("searchByKeyword");
+    auto start = high_resolution_clock::now();
+    bool found = false;
+
+    for (typename ResumeStore::const_iterator resume = resumes.begin(); resume != resumes.end(); ++resume) {
+        for (int i = 0; i < 10; ++i) {
+            if (equalsIgnoreCase(resume->keywords[i], keyword)) {
+                cout << "Resume [" << resume->resumeID << "] matched: " << resume->description << "\n";
+                found = true;
+                break;
+            }
+        }
+    }
+
+    auto end = high_resolution_clock::now();
+    cout << "[Search Performance] (" << ResumeStore::backendName() << "): "
+         << duration_cast<microseconds>(end - start).count()
+         << " microseconds\n";
+    recordLatency("search", ResumeStore::backendName(), duration_cast<microseconds>(end - start).count());
+    if (!found) MetricsRegistry::instance().increment("search_no_results", ResumeStore::backendName());
+
+    if (!found) {
+        cout << "No resumes found with the keyword \"" << keyword << "\".\n";
+        printSuggestions(suggestions, keyword);
+    }
+}
+
+// Print the resumes whose IDs are listed (ascending, as returned by the indexes)
+template <class ResumeStore>
+void Matcher::printResumesByID(const ResumeStore &resumes, const PostingList &ids) {
+    if (ResumeStore::INDEXED_LOOKUP) {
+        for (size_t i = 0; i < ids.size(); ++i) {
+            const typename ResumeStore::record_type *resume = resumes.findByID(ids[i]);
+            if (resume)
+                cout << "Resume [" << resume->resumeID << "] matched: " << resume->description << "\n";
+        }
+        return;
+    }
+
+    // Result IDs are ascending and so is the store: one forward walk
+    typename ResumeStore::const_iterator resume = resumes.begin();
+    for (size_t i = 0; i < ids.size(); ++i) {
+        while (resume != resumes.end() && resume->resumeID < ids[i]) ++resume;
+        if (resume == resumes.end()) break;
+        if (resume->resumeID == ids[i])
+            cout << "Resume [" << resume->resumeID << "] matched: " << resume->description << "\n";
+    }
+}
+
+template <class ResumeStore>
+void Matcher::booleanSearch(const ResumeStore &resumes, const SkillIndex &index) {
+    PostingList ids;
+    bool showResults;
+    BooleanQuery *query = readBooleanQuery(index, ResumeStore::backendName(), ids, showResults);
+    if (!query) return;
+
+    if (showResults) printResumesByID(resumes, ids);
+    delete query;
+}
+
+template <class ResumeStore>
+void Matcher::fullTextSearch(const ResumeStore &resumes, const FullTextIndex &index) {
+    PostingList ids;
+    if (readFullTextQuery(index, ResumeStore::backendName(), ids)) printResumesByID(resumes, ids);
+}
+
+template <class JobStore, class ResumeStore>
+void Matcher::rankedResumesForJob(int jobID, const JobStore &jobs, const ResumeStore &resumes) {
+    using namespace std::chrono;
+    const typename JobStore::record_type *job = jobs.findByID(jobID);
+    if (!job) {
+        cout << "Job ID " << jobID << " not found.\n";
+        return;
+    }
+
+    int jobKeywordCount = countKeywords(job->keywords);
+    if (jobKeywordCount == 0) {
+        cout << "No keywords found for this job.\n";
+        return;
+    }
+
+    cout << "\n=== Ranked Resumes for Job [" << jobID << "] [" << ResumeStore::backendName() << "] (exact match %) ===\n";
+    TRACE_SCOPE("rankedResumesForJob");
+    QueryScope query(ResumeStore::backendName());
+    auto start = high_resolution_clock::now();
+    BucketRanking ranking(jobKeywordCount);
+    ranking.reserve(resumes.size());
+    for (typename ResumeStore::const_iterator resume = resumes.begin(); resume != resumes.end(); ++resume)
+        ranking.add(resume->resumeID, keywordMatchCount(job->keywords, resume->keywords), &resume->description);
+    ranking.finalize();
+    auto end = high_resolution_clock::now();
+
+    cout << "[Performance] Scoring + bucket ranking (" << ResumeStore::backendName() << "): "
+         << duration_cast<microseconds>(end - start).count() << " microseconds\n";
+    recordLatency("rank", ResumeStore::backendName(), duration_cast<microseconds>(end - start).count());
+    browseRanking(ranking);
+}
+
+template <class ResumeStore>
+int Matcher::streamThresholdMatches(const string jobKeywords[10], double minRate, const ResumeStore &resumes,
+                                    const SkillIndex &index, bool showText, ThresholdQuery::Stats &stats) {
+    ThresholdQuery query(index, jobKeywords, minRate);
+    ThresholdPrinter<ResumeStore> printer(resumes, jobKeywords, query, showText);
+    if (query.canPrune()) {
+        stats = query.run(printer);
+    } else {
+        // A 0% cutoff, or a job made of words the index skips: every resume
+        // is a candidate, so score them all in order
+        ThresholdQuery::Stats scan = { 0, 0, 0, 0, 0 };
+        for (typename ResumeStore::const_iterator r = resumes.begin(); r != resumes.end(); ++r) {
+            scan.candidates++;
+            int shared = keywordMatchCount(jobKeywords, r->keywords);
+            if (shared >= query.getMinShared()) { scan.matches++; printer.accept(r->resumeID, shared); }
+        }
+        stats = scan;
+    }
+    return printer.printed;
+}
+
+template <class JobStore, class ResumeStore>
+void Matcher::thresholdMatchForJob(int jobID, const JobStore &jobs, const ResumeStore &resumes,
+                                   const SkillIndex &index) {
+    using namespace std::chrono;
+    const typename JobStore::record_type *job = jobs.findByID(jobID);
+    if (!job) {
+        cout << "Job ID " << jobID << " not found.\n";
+        return;
+    }
+    int jobKeywordCount = countKeywords(job->keywords);
+    if (jobKeywordCount == 0) {
+        cout << "No keywords found for this job.\n";
+        return;
+    }
+
+    double minRate;
+    cout << "Minimum exact match rate % (e.g. 80): ";
+    cin >> minRate;
+    if (cin.fail() || minRate < 0 || minRate > 100) {
+        cin.clear();
+        cin.ignore(10000, '\n');
+        cout << "Invalid rate.\n";
+        return;
+    }
+
+    cout << "\n=== Resumes >= " << minRate << "% exact match for Job [" << jobID << "] [" << ResumeStore::backendName() << "] ===\n";
+    TRACE_SCOPE("thresholdMatchForJob");
+    QueryScope query(ResumeStore::backendName());
+    auto start = high_resolution_clock::now();
+    ThresholdQuery::Stats stats;
+    int found = streamThresholdMatches(job->keywords, minRate, resumes, index, true, stats);
+    auto end = high_resolution_clock::now();
+
+    if (!found) cout << "No resume reaches " << minRate << "%.\n";
+    cout << found << " resume(s); merged " << stats.merged << " of " << stats.lists << " skill lists, "
+         << stats.candidates << " candidates of " << resumes.size() << " resumes, " << stats.probes << " probes\n";
+    cout << "[Performance] Threshold match (" << ResumeStore::backendName() << "): "
+         << duration_cast<microseconds>(end - start).count() << " microseconds\n";
+    recordLatency("threshold", ResumeStore::backendName(), duration_cast<microseconds>(end - start).count());
+}
+
+template <class JobStore, class ResumeStore>
+void Matcher::matchAllJobsBatched(const JobStore &jobs, const ResumeStore &resumes) {
+    using namespace std::chrono;
+    TRACE_SCOPE("matchAllJobsBatched");
+    QueryScope query(ResumeStore::backendName());
+    cout << "\n=== All-vs-All Top 3 [" << ResumeStore::backendName() << "] (exact match %) ===\n";
+
+    auto encodeStart = high_resolution_clock::now();
+    SkillMatrix matrix;
+    matrix.build(jobs, resumes);
+    auto encodeEnd = high_resolution_clock::now();
+    cout << matrix.jobCount() << " jobs x " << matrix.resumeCount() << " resumes, " << matrix.vocabularySize()
+         << " job skills (" << matrix.wordsPerBitset() << " x 64-bit word bitsets, "
+         << matrix.memoryBytes() / 1024 << " KB)\n";
+    cout << "[Performance] Bitset encoding: "
+         << duration_cast<microseconds>(encodeEnd - encodeStart).count() << " microseconds\n";
+
+    // Every kernel this CPU runs, the dispatched one last so its result is kept
+    SkillMatrix::Kernel best = SkillMatrix::bestKernel();
+    BatchTop3 top(matrix.jobCount());
+    double pairs = (double)matrix.jobCount() * matrix.resumeCount();
+    for (int k = 0; k < SkillMatrix::KERNEL_COUNT; ++k) {
+        SkillMatrix::Kernel kernel = (k == SkillMatrix::KERNEL_COUNT - 1) ? best : (SkillMatrix::Kernel)k;
+        if (k < SkillMatrix::KERNEL_COUNT - 1 && (kernel == best || !SkillMatrix::supported(kernel))) continue;
+
+        BatchTop3 run(matrix.jobCount());
+        auto start = high_resolution_clock::now();
+        matrix.scoreAll(run, kernel);
+        auto end = high_resolution_clock::now();
+        long long micros = duration_cast<microseconds>(end - start).count();
+        cout << "[Performance] Batched scoring + top 3 (" << SkillMatrix::kernelName(kernel)
+             << (kernel == best ? ", dispatched" : "") << "): " << micros << " microseconds ("
+             << (micros ? pairs / micros : 0.0) << " M pairs/s)\n";
+        if (kernel == best) {
+            top = run;
+            recordLatency("batch_match", ResumeStore::backendName(), micros);
+        }
+    }
+
+    // Spot check against the per-pair matcher on a spread of jobs
+    int checked = 0, agreed = 0;
+    int step = max(1, matrix.jobCount() / 20);
+    for (int j = 0; j < matrix.jobCount(); j += step) {
+        const typename JobStore::record_type *job = jobs.findByID(matrix.jobID(j));
+        if (!job || matrix.jobKeywordCount(j) == 0) continue;
+        int bestScore = -1;
+        for (typename ResumeStore::const_iterator r = resumes.begin(); r != resumes.end(); ++r)
+            bestScore = max(bestScore, keywordMatchCount(job->keywords, r->keywords));
+        checked++;
+        if (top.top(j)[0].score == bestScore) agreed++;
+    }
+    cout << "Spot check: best score agrees with keywordMatchCount for " << agreed << " of " << checked << " jobs\n";
+
+    for (int j = 0; j < min(3, matrix.jobCount()); ++j) {
+        cout << "Job [" << matrix.jobID(j) << "]:";
+        for (int k = 0; k < 3 && top.top(j)[k].resume >= 0; ++k)
+            cout << " " << matrix.resumeID(top.top(j)[k].resume) << " ("
+                 << (matrix.jobKeywordCount(j) ? top.top(j)[k].score * 100.0 / matrix.jobKeywordCount(j) : 0.0) << "%)";
+        cout << "\n";
+    }
+    if (top.writeCSV("batch_top3.csv", matrix)) cout << "Top 3 of every job written to batch_top3.csv\n";
+}
+
+template <class JobStore>
+void Matcher::matchTop3ForJobSharded(int jobID, const JobStore &jobs, const ShardedResumeStore &store) {
+    using namespace std::chrono;
+    const typename JobStore::record_type *job = jobs.findByID(jobID);
+    if (!job) {
+        cout << "Job ID " << jobID << " not found.\n";
+        return;
+    }
+
+    cout << "\n=== Matching Resumes for Job [" << jobID << "] [Sharded x" << store.shardCount() << "] ===\n";
+
+    TRACE_SCOPE("matchTop3ForJobSharded");
+    auto start = high_resolution_clock::now();
+    vector<ShardMatch> top = store.matchTopK(job->keywords, 3);
+    auto end = high_resolution_clock::now();
+
+    for (size_t t = 0; t < top.size(); ++t)
+        cout << t + 1 << ". Resume [" << top[t].resumeID << "] (" << top[t].rate << "%)\n"
+             << store.getDescription(top[t].resumeID) << "\n";
+    cout << "[Performance] Sharded scatter-gather top 3 execution time: "
+         << duration_cast<microseconds>(end - start).count()
+         << " microseconds\n";
+    recordLatency("match", "Sharded", duration_cast<microseconds>(end - start).count());
+}
+
 #endif
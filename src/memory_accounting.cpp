@@ -0,0 +1,183 @@
+#include "memory_accounting.h"
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <atomic>
+#include <cstdlib>
+#include <cstddef>
+#include <new>
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#endif
+using namespace std;
+
+// Tag 0 is "other"; store s, kind k is tag 1 + s * KIND_COUNT + k
+static const int TAG_COUNT = 1 + MemoryAccounting::MAX_STORES * MemoryAccounting::KIND_COUNT;
+
+// Plain zero-initialised statics: operator new can run before main()
+static atomic<long long> tagBytes[TAG_COUNT];
+static atomic<long long> totalBytes;
+static atomic<long long> peakBytes;
+static atomic<long long> allocations;
+static const char *storeNames[MemoryAccounting::MAX_STORES];
+static atomic<int> storeCount;
+static thread_local int currentTag = 0;
+
+// ---------------- tracking allocator ----------------
+struct alignas(alignof(max_align_t)) BlockHeader {
+    size_t size;
+    int tag;
+};
+
+static void* trackedAlloc(size_t size) {
+    BlockHeader *block = (BlockHeader*)malloc(sizeof(BlockHeader) + size);
+    if (!block) return nullptr;
+    block->size = size;
+    block->tag = currentTag;
+    allocations.fetch_add(1, memory_order_relaxed);
+    tagBytes[block->tag].fetch_add((long long)size, memory_order_relaxed);
+    long long now = totalBytes.fetch_add((long long)size, memory_order_relaxed) + (long long)size;
+    long long peak = peakBytes.load(memory_order_relaxed);
+    while (now > peak && !peakBytes.compare_exchange_weak(peak, now, memory_order_relaxed)) {}
+    return block + 1;
+}
+
+static void trackedFree(void *p) {
+    if (!p) return;
+    BlockHeader *block = (BlockHeader*)p - 1;
+    tagBytes[block->tag].fetch_sub((long long)block->size, memory_order_relaxed);
+    totalBytes.fetch_sub((long long)block->size, memory_order_relaxed);
+    free(block);
+}
+
+void* operator new(size_t size) {
+    void *p = trackedAlloc(size);
+    if (!p) throw bad_alloc();
+    return p;
+}
+void* operator new[](size_t size) {
+    void *p = trackedAlloc(size);
+    if (!p) throw bad_alloc();
+    return p;
+}
+void* operator new(size_t size, const nothrow_t&) noexcept { return trackedAlloc(size); }
+void* operator new[](size_t size, const nothrow_t&) noexcept { return trackedAlloc(size); }
+void operator delete(void *p) noexcept { trackedFree(p); }
+void operator delete[](void *p) noexcept { trackedFree(p); }
+void operator delete(void *p, size_t) noexcept { trackedFree(p); }
+void operator delete[](void *p, size_t) noexcept { trackedFree(p); }
+void operator delete(void *p, const nothrow_t&) noexcept { trackedFree(p); }
+void operator delete[](void *p, const nothrow_t&) noexcept { trackedFree(p); }
+
+// ---------------- MemoryScope ----------------
+MemoryScope::MemoryScope(int store, MemoryAccounting::Kind kind) : previous(currentTag) {
+    if (store >= 0 && store < MemoryAccounting::MAX_STORES)
+        currentTag = 1 + store * MemoryAccounting::KIND_COUNT + kind;
+}
+
+MemoryScope::~MemoryScope() {
+    currentTag = previous;
+}
+
+// ---------------- MemoryAccounting ----------------
+int MemoryAccounting::registerStore(const char *name) {
+    int slot = storeCount.fetch_add(1);
+    if (slot >= MAX_STORES) return -1;   // counted as "other"
+    storeNames[slot] = name;
+    return slot;
+}
+
+long long MemoryAccounting::storeBytes(int store, Kind kind) {
+    if (store < 0 || store >= MAX_STORES) return 0;
+    return tagBytes[1 + store * KIND_COUNT + kind].load(memory_order_relaxed);
+}
+
+long long MemoryAccounting::storeBytes(int store) {
+    long long sum = 0;
+    for (int k = 0; k < KIND_COUNT; ++k) sum += storeBytes(store, (Kind)k);
+    return sum;
+}
+
+long long MemoryAccounting::heapBytes() { return totalBytes.load(memory_order_relaxed); }
+long long MemoryAccounting::peakHeapBytes() { return peakBytes.load(memory_order_relaxed); }
+long long MemoryAccounting::untrackedBytes() { return tagBytes[0].load(memory_order_relaxed); }
+long long MemoryAccounting::allocationCount() { return allocations.load(memory_order_relaxed); }
+
+const char* MemoryAccounting::kindName(int kind) {
+    static const char *names[KIND_COUNT] = { "nodes", "descriptions", "keywords", "indexes" };
+    return (kind >= 0 && kind < KIND_COUNT) ? names[kind] : "";
+}
+
+vector<MemoryAccounting::Usage> MemoryAccounting::snapshot() {
+    vector<Usage> rows;
+    int stores = storeCount.load();
+    if (stores > MAX_STORES) stores = MAX_STORES;
+    for (int s = 0; s < stores; ++s) {
+        Usage row;
+        row.store = storeNames[s];
+        row.total = 0;
+        for (int k = 0; k < KIND_COUNT; ++k) {
+            row.bytes[k] = storeBytes(s, (Kind)k);
+            row.total += row.bytes[k];
+        }
+        rows.push_back(row);
+    }
+    return rows;
+}
+
+// ---------------- process RSS ----------------
+#if defined(__linux__)
+static long long procStatusKB(const string &field) {
+    ifstream status("/proc/self/status");
+    string key;
+    long long value;
+    while (status >> key) {
+        if (key == field) return (status >> value) ? value : 0;
+        status.ignore(10000, '\n');
+    }
+    return 0;
+}
+#endif
+
+long long MemoryAccounting::residentKB() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) return (long long)(pmc.WorkingSetSize / 1024);
+    return 0;
+#elif defined(__linux__)
+    return procStatusKB("VmRSS:");
+#else
+    return 0;
+#endif
+}
+
+long long MemoryAccounting::peakResidentKB() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) return (long long)(pmc.PeakWorkingSetSize / 1024);
+    return 0;
+#elif defined(__linux__)
+    return procStatusKB("VmHWM:");
+#else
+    return 0;
+#endif
+}
+
+// ---------------- report ----------------
+void MemoryAccounting::printReport() {
+    vector<Usage> rows = snapshot();
+    cout << left << setw(20) << "store" << right;
+    for (int k = 0; k < KIND_COUNT; ++k) cout << setw(14) << kindName(k);
+    cout << setw(14) << "total" << "   (KB)\n";
+    for (size_t r = 0; r < rows.size(); ++r) {
+        cout << left << setw(20) << rows[r].store << right;
+        for (int k = 0; k < KIND_COUNT; ++k) cout << setw(14) << rows[r].bytes[k] / 1024;
+        cout << setw(14) << rows[r].total / 1024 << "\n";
+    }
+    cout << left;
+    cout << "Other heap (temporaries, menus, libraries): " << untrackedBytes() / 1024 << " KB\n";
+    cout << "Heap in use: " << heapBytes() / 1024 << " KB (peak " << peakHeapBytes() / 1024 << " KB)\n";
+    cout << "Process RSS: " << residentKB() << " KB (peak " << peakResidentKB() << " KB)\n";
+}
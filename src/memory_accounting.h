@@ -0,0 +1,55 @@
+#ifndef MEMORY_ACCOUNTING_H
+#define MEMORY_ACCOUNTING_H
+
+#include <string>
+#include <vector>
+using namespace std;
+
+// Exact heap accounting. The global operator new/delete are replaced by a
+// tracking allocator that prefixes every block with its size and the tag
+// that was active when it was allocated, so a block is always credited back
+// to the same store and kind when it is freed, wherever that happens.
+// Containers open a MemoryScope around each step of an insert; allocations
+// outside any scope are counted as "other".
+class MemoryAccounting {
+public:
+    enum Kind { NODES, DESCRIPTIONS, KEYWORDS, INDEXES, KIND_COUNT };
+    static const int MAX_STORES = 16;
+
+    struct Usage {
+        string store;
+        long long bytes[KIND_COUNT];
+        long long total;
+    };
+
+    // Call once per store type (e.g. a file-scope static); returns its slot
+    static int registerStore(const char *name);
+
+    static long long storeBytes(int store);
+    static long long storeBytes(int store, Kind kind);
+    static long long heapBytes();        // everything currently allocated
+    static long long peakHeapBytes();
+    static long long untrackedBytes();   // allocated outside any scope
+    static long long allocationCount();  // operator new calls so far, any thread
+
+    static vector<Usage> snapshot();
+    static const char* kindName(int kind);
+
+    // Resident set size of the whole process (0 if the OS will not say)
+    static long long residentKB();
+    static long long peakResidentKB();
+
+    static void printReport();
+};
+
+// Attributes allocations on this thread to (store, kind) until destroyed
+class MemoryScope {
+private:
+    int previous;
+
+public:
+    MemoryScope(int store, MemoryAccounting::Kind kind);
+    ~MemoryScope();
+};
+
+#endif
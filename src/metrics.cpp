@@ -0,0 +1,168 @@
+#include "metrics.h"
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <cstdio>
+using namespace std;
+
+// ---------------- LatencyHistogram ----------------
+LatencyHistogram::LatencyHistogram() : total(0), sum(0), maxValue(0) {
+    for (int i = 0; i < BUCKETS; ++i) buckets[i].store(0, memory_order_relaxed);
+}
+
+int LatencyHistogram::bucketOf(long long value) {
+    if (value < 0) value = 0;
+    if (value < LINEAR) return (int)value;
+
+    int msb = 63;
+    while (!((unsigned long long)value >> msb)) msb--;
+    int exponent = msb - 6;                       // value >> exponent is in [64, 128)
+    if (exponent > MAX_EXPONENT) return BUCKETS - 1;
+    int sub = (int)(value >> exponent) - SUB_BUCKETS;
+    return LINEAR + (exponent - 1) * SUB_BUCKETS + sub;
+}
+
+long long LatencyHistogram::bucketUpperBound(int index) {
+    if (index < LINEAR) return index;
+    int exponent = (index - LINEAR) / SUB_BUCKETS + 1;
+    long long sub = (index - LINEAR) % SUB_BUCKETS + SUB_BUCKETS;
+    return ((sub + 1) << exponent) - 1;
+}
+
+void LatencyHistogram::record(long long micros) {
+    if (micros < 0) micros = 0;
+    buckets[bucketOf(micros)].fetch_add(1, memory_order_relaxed);
+    total.fetch_add(1, memory_order_relaxed);
+    sum.fetch_add(micros, memory_order_relaxed);
+    long long seen = maxValue.load(memory_order_relaxed);
+    while (micros > seen && !maxValue.compare_exchange_weak(seen, micros, memory_order_relaxed)) {}
+}
+
+long long LatencyHistogram::percentile(double q) const {
+    long long n = count();
+    if (n == 0) return 0;
+    long long rank = (long long)(q * n + 0.5);
+    if (rank < 1) rank = 1;
+    if (rank > n) rank = n;
+
+    long long seen = 0;
+    for (int i = 0; i < BUCKETS; ++i) {
+        seen += buckets[i].load(memory_order_relaxed);
+        if (seen >= rank) {
+            long long bound = bucketUpperBound(i);
+            return bound < max() ? bound : max();
+        }
+    }
+    return max();
+}
+
+// ---------------- MetricsRegistry ----------------
+MetricsRegistry& MetricsRegistry::instance() {
+    static MetricsRegistry registry;
+    return registry;
+}
+
+MetricsRegistry::~MetricsRegistry() {
+    for (map<Key, LatencyHistogram*>::iterator it = histograms.begin(); it != histograms.end(); ++it)
+        delete it->second;
+    for (map<Key, atomic<long long>*>::iterator it = counters.begin(); it != counters.end(); ++it)
+        delete it->second;
+}
+
+LatencyHistogram& MetricsRegistry::histogram(const string &operation, const string &backend) {
+    lock_guard<mutex> guard(lock);
+    LatencyHistogram *&h = histograms[Key(operation, backend)];
+    if (!h) h = new LatencyHistogram();
+    return *h;
+}
+
+long long MetricsRegistry::totalMicros(const string &operation, const string &backend) const {
+    lock_guard<mutex> guard(lock);
+    map<Key, LatencyHistogram*>::const_iterator it = histograms.find(Key(operation, backend));
+    return (it == histograms.end()) ? 0 : it->second->totalMicros();
+}
+
+long long MetricsRegistry::sampleCount(const string &operation, const string &backend) const {
+    lock_guard<mutex> guard(lock);
+    map<Key, LatencyHistogram*>::const_iterator it = histograms.find(Key(operation, backend));
+    return (it == histograms.end()) ? 0 : it->second->count();
+}
+
+void MetricsRegistry::increment(const string &counter, const string &backend, long long by) {
+    atomic<long long> *value;
+    {
+        lock_guard<mutex> guard(lock);
+        atomic<long long> *&slot = counters[Key(counter, backend)];
+        if (!slot) slot = new atomic<long long>(0);
+        value = slot;
+    }
+    value->fetch_add(by, memory_order_relaxed);
+}
+
+static string labels(const string &operation, const string &backend) {
+    return "operation=\"" + operation + "\",backend=\"" + backend + "\"";
+}
+
+void MetricsRegistry::writePrometheus(ostream &out) const {
+    lock_guard<mutex> guard(lock);
+    static const double quantiles[] = { 0.5, 0.9, 0.99 };
+
+    out << "# HELP jobmatch_latency_microseconds Latency of core operations.\n";
+    out << "# TYPE jobmatch_latency_microseconds summary\n";
+    for (map<Key, LatencyHistogram*>::const_iterator it = histograms.begin(); it != histograms.end(); ++it) {
+        string l = labels(it->first.first, it->first.second);
+        for (int q = 0; q < 3; ++q)
+            out << "jobmatch_latency_microseconds{" << l << ",quantile=\"" << quantiles[q] << "\"} "
+                << it->second->percentile(quantiles[q]) << "\n";
+        out << "jobmatch_latency_microseconds_sum{" << l << "} " << it->second->totalMicros() << "\n";
+        out << "jobmatch_latency_microseconds_count{" << l << "} " << it->second->count() << "\n";
+    }
+
+    out << "# HELP jobmatch_latency_max_microseconds Slowest observed call.\n";
+    out << "# TYPE jobmatch_latency_max_microseconds gauge\n";
+    for (map<Key, LatencyHistogram*>::const_iterator it = histograms.begin(); it != histograms.end(); ++it)
+        out << "jobmatch_latency_max_microseconds{" << labels(it->first.first, it->first.second) << "} "
+            << it->second->max() << "\n";
+
+    if (!counters.empty()) {
+        out << "# HELP jobmatch_events_total Event counters.\n";
+        out << "# TYPE jobmatch_events_total counter\n";
+        for (map<Key, atomic<long long>*>::const_iterator it = counters.begin(); it != counters.end(); ++it)
+            out << "jobmatch_events_total{event=\"" << it->first.first << "\",backend=\"" << it->first.second
+                << "\"} " << it->second->load(memory_order_relaxed) << "\n";
+    }
+}
+
+bool MetricsRegistry::dumpToFile(const string &filename) const {
+    // Scrapers never see a half-written file: write aside, then rename. The
+    // dumper thread and the server's "metrics" command share the temp name.
+    lock_guard<mutex> guard(dumpLock);
+    string temp = filename + ".tmp";
+    {
+        ofstream out(temp);
+        if (!out.is_open()) return false;
+        writePrometheus(out);
+    }
+#ifdef _WIN32
+    remove(filename.c_str());   // rename() does not replace on Windows
+#endif
+    return rename(temp.c_str(), filename.c_str()) == 0;
+}
+
+void MetricsRegistry::printSummary() const {
+    lock_guard<mutex> guard(lock);
+    if (histograms.empty()) {
+        cout << "No latencies recorded yet.\n";
+        return;
+    }
+    cout << left << setw(18) << "operation" << setw(13) << "backend" << right
+         << setw(8) << "count" << setw(10) << "p50" << setw(10) << "p90"
+         << setw(10) << "p99" << setw(10) << "max" << "   (microseconds)\n";
+    for (map<Key, LatencyHistogram*>::const_iterator it = histograms.begin(); it != histograms.end(); ++it) {
+        const LatencyHistogram &h = *it->second;
+        cout << left << setw(18) << it->first.first << setw(13) << it->first.second << right
+             << setw(8) << h.count() << setw(10) << h.percentile(0.5) << setw(10) << h.percentile(0.9)
+             << setw(10) << h.percentile(0.99) << setw(10) << h.max() << "\n";
+    }
+    cout << left;
+}
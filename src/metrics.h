@@ -0,0 +1,82 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <string>
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <ostream>
+using namespace std;
+
+// HDR-style log-linear latency histogram (values in microseconds).
+// Values below 128 get exact buckets; above that every power of two is
+// split into 64 linear sub-buckets, so a bucket is never wider than 1/64
+// (about 1.6%) of its value. Recording is one index computation plus a
+// relaxed atomic increment, so it is cheap and safe from any thread.
+class LatencyHistogram {
+public:
+    static const int LINEAR = 128;            // exact buckets for 0..127
+    static const int SUB_BUCKETS = 64;        // per power of two above that
+    static const int MAX_EXPONENT = 34;       // covers values up to ~2^40 us
+    static const int BUCKETS = LINEAR + MAX_EXPONENT * SUB_BUCKETS;
+
+private:
+    atomic<long long> buckets[BUCKETS];
+    atomic<long long> total;
+    atomic<long long> sum;
+    atomic<long long> maxValue;
+
+    static int bucketOf(long long value);
+    static long long bucketUpperBound(int index);
+
+public:
+    LatencyHistogram();
+
+    void record(long long micros);
+    long long count() const { return total.load(memory_order_relaxed); }
+    long long totalMicros() const { return sum.load(memory_order_relaxed); }
+    long long max() const { return maxValue.load(memory_order_relaxed); }
+
+    // Value at quantile q (0..1), accurate to the bucket width
+    long long percentile(double q) const;
+};
+
+// Named histograms and counters, labelled by backend ("Array",
+// "Linked List", ...). Created on first use and kept for the whole run.
+class MetricsRegistry {
+private:
+    typedef pair<string, string> Key;         // (operation, backend)
+    map<Key, LatencyHistogram*> histograms;
+    map<Key, atomic<long long>*> counters;
+    mutable mutex lock;                       // guards the maps, not the values
+    mutable mutex dumpLock;                   // one writer of the .tmp file at a time
+
+    MetricsRegistry() {}
+    MetricsRegistry(const MetricsRegistry&);
+    MetricsRegistry& operator=(const MetricsRegistry&);
+
+public:
+    ~MetricsRegistry();
+    static MetricsRegistry& instance();
+
+    LatencyHistogram& histogram(const string &operation, const string &backend);
+    void increment(const string &counter, const string &backend, long long by = 1);
+
+    // Sum recorded so far for one histogram (0 if it was never used; does not create it)
+    long long totalMicros(const string &operation, const string &backend) const;
+    long long sampleCount(const string &operation, const string &backend) const;
+
+    // Prometheus text exposition format
+    void writePrometheus(ostream &out) const;
+    bool dumpToFile(const string &filename) const;   // written atomically via rename
+
+    // Human-readable p50/p90/p99/max table
+    void printSummary() const;
+};
+
+// Shorthand used next to the existing [Performance] timers
+inline void recordLatency(const string &operation, const string &backend, long long micros) {
+    MetricsRegistry::instance().histogram(operation, backend).record(micros);
+}
+
+#endif
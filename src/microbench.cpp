@@ -0,0 +1,375 @@
+#include "microbench.h"
+#include "job_linkedlist.h"
+#include "job_array.h"
+#include "resume_linkedlist.h"
+#include "resume_array.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+using namespace std;
+using namespace std::chrono;
+
+struct MicrobenchOptions {
+    vector<int> sizes;
+    int reps;
+    int warmup;
+    string baselineFile;
+    bool updateBaseline;
+    double threshold;
+};
+
+struct Sample {
+    string operation;
+    string backend;
+    int n;
+    int batch;             // operations per timed repetition
+    double meanNs;         // per operation
+    double ciNs;           // half-width of the 95% confidence interval
+    double medianNs;
+};
+
+static const double BATCH_TARGET_NS = 2e6;   // aim for ~2 ms per timed batch
+static const int MAX_BATCH = 1000;
+static volatile long long sink;              // keeps results observable
+
+// ---------------- statistics ----------------
+// Two-sided 95% Student t quantiles for 1..30 degrees of freedom
+static double tQuantile95(int df) {
+    static const double table[] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+    };
+    if (df < 1) return 0;
+    return df <= 30 ? table[df - 1] : 1.96;
+}
+
+static Sample summarize(const string &operation, const string &backend, int n, int batch, vector<double> perOp) {
+    Sample s;
+    s.operation = operation;
+    s.backend = backend;
+    s.n = n;
+    s.batch = batch;
+
+    double sum = 0;
+    for (size_t i = 0; i < perOp.size(); ++i) sum += perOp[i];
+    s.meanNs = sum / perOp.size();
+
+    double squares = 0;
+    for (size_t i = 0; i < perOp.size(); ++i) squares += (perOp[i] - s.meanNs) * (perOp[i] - s.meanNs);
+    double stddev = perOp.size() > 1 ? sqrt(squares / (perOp.size() - 1)) : 0;
+    s.ciNs = tQuantile95((int)perOp.size() - 1) * stddev / sqrt((double)perOp.size());
+
+    sort(perOp.begin(), perOp.end());
+    size_t mid = perOp.size() / 2;
+    s.medianNs = perOp.size() % 2 ? perOp[mid] : (perOp[mid - 1] + perOp[mid]) / 2;
+    return s;
+}
+
+// Times op() in batches. restore(count) undoes count ops outside the timer
+// so every repetition starts from the same store size.
+template <class Op, class Restore>
+static Sample measure(const string &operation, const string &backend, int n, int maxBatch,
+                      const MicrobenchOptions &opt, Op op, Restore restore) {
+    auto calibrateStart = steady_clock::now();
+    op();
+    double single = (double)duration_cast<nanoseconds>(steady_clock::now() - calibrateStart).count();
+    restore(1);
+
+    int batch = (int)(BATCH_TARGET_NS / max(single, 1.0));
+    batch = max(1, min(batch, min(MAX_BATCH, maxBatch)));
+
+    for (int w = 0; w < opt.warmup; ++w) {
+        for (int b = 0; b < batch; ++b) op();
+        restore(batch);
+    }
+
+    vector<double> perOp;
+    for (int r = 0; r < opt.reps; ++r) {
+        auto start = steady_clock::now();
+        for (int b = 0; b < batch; ++b) op();
+        auto end = steady_clock::now();
+        perOp.push_back((double)duration_cast<nanoseconds>(end - start).count() / batch);
+        restore(batch);
+    }
+
+    Sample s = summarize(operation, backend, n, batch, perOp);
+    cout << "  " << left << setw(26) << operation << setw(13) << backend << right << setw(9) << n
+         << setw(14) << fixed << setprecision(1) << s.meanNs << " +/- " << setw(9) << s.ciNs
+         << " ns/op  (batch " << batch << ")\n" << defaultfloat << left;
+    return s;
+}
+
+// ---------------- per-backend helpers ----------------
+static void extract(Job &job) { JobArray::extractInfo(job); }
+static void extract(JobNode &node) { extractInfo(&node); }
+static void extract(Resume &resume) { ResumeArray::extractKeywords(resume); }
+static void extract(ResumeNode &node) { extractResumeKeywords(&node); }
+
+static const Job& jobAt(const JobArray &jobs, int index) { return jobs.getJob(index); }
+
+// The list has no positional getter; walk like a caller would have to
+template <class Store>
+static const typename Store::record_type& jobAt(const Store &jobs, int index) {
+    typename Store::const_iterator it = jobs.begin();
+    for (int i = 0; i < index; ++i) ++it;
+    return *it;
+}
+
+// Arrays shrink cheaply at the tail, singly linked lists at the head
+template <class Store>
+static void removeCheapest(Store &store) {
+    store.removeAt(Store::INDEXED_LOOKUP ? store.size() : 1);
+}
+
+template <class Store>
+static void fill(Store &store, const vector<string> &lines, int n) {
+    for (int i = 0; i < n; ++i) store.insertAtEnd(lines[i % lines.size()]);
+}
+
+template <class JobStore>
+static void benchmarkJobStore(int n, const vector<string> &jobLines, const MicrobenchOptions &opt,
+                              vector<Sample> &samples) {
+    const char *backend = JobStore::backendName();
+    JobStore jobs;
+    fill(jobs, jobLines, n);
+
+    mt19937 random(12345);
+    vector<int> ids, positions;
+    for (typename JobStore::const_iterator it = jobs.begin(); it != jobs.end(); ++it) ids.push_back(it->jobID);
+    shuffle(ids.begin(), ids.end(), random);
+    for (int i = 0; i < 4096; ++i) positions.push_back((int)(random() % n));
+
+    size_t next = 0;
+    auto none = [](int) {};
+    samples.push_back(measure("findJobByID", backend, n, MAX_BATCH, opt, [&] {
+        sink += jobs.findJobByID(ids[next++ % ids.size()]) != nullptr;
+    }, none));
+    samples.push_back(measure("getJob", backend, n, MAX_BATCH, opt, [&] {
+        sink += jobAt(jobs, positions[next++ % positions.size()]).jobID;
+    }, none));
+
+    // Mutations: keep the size within half of n in every direction
+    int maxBatch = max(1, n / 2);
+    auto refill = [&](int count) {
+        for (int i = 0; i < count; ++i) jobs.insertAtEnd(jobLines[next++ % jobLines.size()]);
+    };
+    auto shrink = [&](int count) {
+        for (int i = 0; i < count; ++i) removeCheapest(jobs);
+    };
+    samples.push_back(measure("insertAtEnd", backend, n, maxBatch, opt, [&] {
+        jobs.insertAtEnd(jobLines[next++ % jobLines.size()]);
+    }, shrink));
+    samples.push_back(measure("deleteFromHead", backend, n, maxBatch, opt, [&] {
+        jobs.removeAt(1);
+    }, refill));
+    samples.push_back(measure("deleteFromMiddle", backend, n, maxBatch, opt, [&] {
+        jobs.removeAt(jobs.size() / 2 + 1);
+    }, refill));
+    samples.push_back(measure("deleteFromTail", backend, n, maxBatch, opt, [&] {
+        jobs.removeAt(jobs.size());
+    }, refill));
+}
+
+// Extraction cost does not depend on the store size, so it is measured once
+template <class JobStore, class ResumeStore>
+static void benchmarkExtraction(const vector<string> &jobLines, const vector<string> &resumeLines,
+                                const MicrobenchOptions &opt, vector<Sample> &samples) {
+    JobStore jobs;
+    ResumeStore resumes;
+    fill(jobs, jobLines, (int)jobLines.size());
+    fill(resumes, resumeLines, (int)resumeLines.size());
+    vector<typename JobStore::record_type> jobRecords(jobs.begin(), jobs.end());
+    vector<typename ResumeStore::record_type> resumeRecords(resumes.begin(), resumes.end());
+
+    size_t next = 0;
+    auto none = [](int) {};
+    samples.push_back(measure("extractInfo (job)", JobStore::backendName(), 1, MAX_BATCH, opt, [&] {
+        typename JobStore::record_type &job = jobRecords[next++ % jobRecords.size()];
+        extract(job);
+        sink += job.keywords[0].size();
+    }, none));
+    samples.push_back(measure("extractKeywords (resume)", ResumeStore::backendName(), 1, MAX_BATCH, opt, [&] {
+        typename ResumeStore::record_type &resume = resumeRecords[next++ % resumeRecords.size()];
+        extract(resume);
+        sink += resume.keywords[0].size();
+    }, none));
+}
+
+// ---------------- input ----------------
+static vector<string> readLines(const string &filename) {
+    vector<string> lines;
+    ifstream file(filename);
+    string line;
+    getline(file, line);   // header
+    while (getline(file, line))
+        if (!line.empty()) lines.push_back(line);
+    return lines;
+}
+
+static bool parseOptions(int argc, char *argv[], MicrobenchOptions &opt) {
+    opt.sizes.clear();
+    opt.reps = 15;
+    opt.warmup = 3;
+    opt.baselineFile = "microbench_baseline.csv";
+    opt.updateBaseline = false;
+    opt.threshold = 0.10;
+
+    string sizes = "1000,10000,100000";
+    for (int i = 2; i < argc; ++i) {
+        string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--sizes" && hasValue) sizes = argv[++i];
+        else if (arg == "--reps" && hasValue) opt.reps = max(2, atoi(argv[++i]));
+        else if (arg == "--warmup" && hasValue) opt.warmup = max(0, atoi(argv[++i]));
+        else if (arg == "--baseline" && hasValue) opt.baselineFile = argv[++i];
+        else if (arg == "--threshold" && hasValue) opt.threshold = atof(argv[++i]);
+        else if (arg == "--update-baseline") opt.updateBaseline = true;
+        else {
+            cout << "Unknown microbench option " << arg << "\n";
+            return false;
+        }
+    }
+
+    stringstream ss(sizes);
+    string token;
+    while (getline(ss, token, ','))
+        if (atoi(token.c_str()) >= 2) opt.sizes.push_back(atoi(token.c_str()));
+    sort(opt.sizes.begin(), opt.sizes.end());
+    return !opt.sizes.empty();
+}
+
+// ---------------- output ----------------
+static string sampleKey(const string &operation, const string &backend, int n) {
+    return operation + "," + backend + "," + to_string(n);
+}
+
+static void printComplexity(const vector<Sample> &samples) {
+    cout << "\n=== Complexity (time vs N) ===\n";
+    map<string, vector<const Sample*> > curves;
+    for (size_t i = 0; i < samples.size(); ++i)
+        curves[samples[i].operation + " [" + samples[i].backend + "]"].push_back(&samples[i]);
+
+    for (map<string, vector<const Sample*> >::iterator it = curves.begin(); it != curves.end(); ++it) {
+        const vector<const Sample*> &curve = it->second;
+        if (curve.size() < 2) continue;
+        cout << "  " << left << setw(40) << it->first;
+        for (size_t i = 0; i < curve.size(); ++i)
+            cout << " N=" << curve[i]->n << ": " << fixed << setprecision(1) << curve[i]->meanNs << "ns";
+        double exponent = log(curve.back()->meanNs / curve.front()->meanNs)
+                        / log((double)curve.back()->n / curve.front()->n);
+        cout << setprecision(2) << "  -> ~N^" << exponent
+             << (exponent < 0.15 ? " (constant)" : exponent < 0.5 ? " (logarithmic / sublinear)"
+                 : exponent < 1.25 ? " (linear)" : " (superlinear)")
+             << "\n" << defaultfloat;
+    }
+}
+
+static void writeCurves(const string &filename, const vector<Sample> &samples) {
+    ofstream out(filename);
+    out << "operation,backend,n,batch,mean_ns,ci95_ns,median_ns\n";
+    for (size_t i = 0; i < samples.size(); ++i)
+        out << samples[i].operation << "," << samples[i].backend << "," << samples[i].n << "," << samples[i].batch
+            << "," << samples[i].meanNs << "," << samples[i].ciNs << "," << samples[i].medianNs << "\n";
+}
+
+struct Baseline {
+    double meanNs;
+    double ciNs;
+};
+
+static map<string, Baseline> readBaseline(const string &filename) {
+    map<string, Baseline> baseline;
+    ifstream in(filename);
+    string line;
+    getline(in, line);   // header
+    while (getline(in, line)) {
+        // operation,backend,n,mean_ns,ci95_ns (operation names contain no commas)
+        size_t ci = line.rfind(',');
+        if (ci == string::npos || ci == 0) continue;
+        size_t mean = line.rfind(',', ci - 1);
+        if (mean == string::npos) continue;
+        Baseline entry = { atof(line.substr(mean + 1, ci - mean - 1).c_str()), atof(line.substr(ci + 1).c_str()) };
+        baseline[line.substr(0, mean)] = entry;
+    }
+    return baseline;
+}
+
+static void writeBaseline(const string &filename, const vector<Sample> &samples) {
+    ofstream out(filename);
+    out << "operation,backend,n,mean_ns,ci95_ns\n";
+    for (size_t i = 0; i < samples.size(); ++i)
+        out << sampleKey(samples[i].operation, samples[i].backend, samples[i].n) << ","
+            << samples[i].meanNs << "," << samples[i].ciNs << "\n";
+}
+
+// Slower than threshold AND the two confidence intervals do not overlap
+static int compareWithBaseline(const map<string, Baseline> &baseline, const vector<Sample> &samples, double threshold) {
+    cout << "\n=== Baseline comparison (threshold " << threshold * 100 << "%) ===\n";
+    int regressions = 0;
+    for (size_t i = 0; i < samples.size(); ++i) {
+        const Sample &s = samples[i];
+        map<string, Baseline>::const_iterator base = baseline.find(sampleKey(s.operation, s.backend, s.n));
+        if (base == baseline.end() || base->second.meanNs <= 0) continue;
+
+        double change = (s.meanNs - base->second.meanNs) / base->second.meanNs;
+        bool regressed = change > threshold && s.meanNs - s.ciNs > base->second.meanNs + base->second.ciNs;
+        if (regressed) regressions++;
+        cout << "  " << left << setw(26) << s.operation << setw(13) << s.backend << right << setw(9) << s.n
+             << setw(10) << fixed << setprecision(1) << (change * 100) << "%"
+             << (regressed ? "  REGRESSION" : change < -threshold ? "  faster" : "") << "\n" << defaultfloat << left;
+    }
+    cout << regressions << " regression(s)\n";
+    return regressions;
+}
+
+// ---------------- entry ----------------
+int runMicrobench(int argc, char *argv[], const string &jobFile, const string &resumeFile) {
+    cout << "========================================\n";
+    cout << "            Micro-benchmarks            \n";
+    cout << "========================================\n";
+
+    MicrobenchOptions opt;
+    if (!parseOptions(argc, argv, opt)) return 1;
+    vector<string> jobLines = readLines(jobFile);
+    vector<string> resumeLines = readLines(resumeFile);
+    if (jobLines.empty() || resumeLines.empty()) {
+        cout << "No input records.\n";
+        return 1;
+    }
+
+    cout << opt.warmup << " warm-up + " << opt.reps << " timed batches per primitive\n";
+    vector<Sample> samples;
+    benchmarkExtraction<JobLinkedList, ResumeLinkedList>(jobLines, resumeLines, opt, samples);
+    benchmarkExtraction<JobArray, ResumeArray>(jobLines, resumeLines, opt, samples);
+    for (size_t i = 0; i < opt.sizes.size(); ++i) {
+        cout << "\n--- N = " << opt.sizes[i] << " ---\n";
+        benchmarkJobStore<JobLinkedList>(opt.sizes[i], jobLines, opt, samples);
+        benchmarkJobStore<JobArray>(opt.sizes[i], jobLines, opt, samples);
+    }
+
+    printComplexity(samples);
+    writeCurves("microbench_curves.csv", samples);
+    cout << "\nCurves written to microbench_curves.csv\n";
+
+    int regressions = 0;
+    map<string, Baseline> baseline = readBaseline(opt.baselineFile);
+    if (!baseline.empty())
+        regressions = compareWithBaseline(baseline, samples, opt.threshold);
+    else
+        cout << "No baseline at " << opt.baselineFile << " (run with --update-baseline to store one)\n";
+
+    if (opt.updateBaseline) {
+        writeBaseline(opt.baselineFile, samples);
+        cout << "Baseline written to " << opt.baselineFile << "\n";
+    }
+    return regressions > 0 ? 1 : 0;
+}
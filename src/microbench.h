@@ -0,0 +1,21 @@
+#ifndef MICROBENCH_H
+#define MICROBENCH_H
+
+#include <string>
+using namespace std;
+
+// Micro-benchmarks for the container primitives (run with:
+//   main --microbench [--sizes 1000,10000,100000] [--reps 15] [--warmup 3]
+//                     [--baseline file] [--update-baseline] [--threshold 0.10])
+//
+// Every primitive (insertAtEnd, delete head/middle/tail, findJobByID,
+// getJob, keyword extraction) is timed on both backends at each size, with
+// warm-up runs and repeated batches, and reported as mean ns/op with a 95%
+// confidence interval. The growth between sizes is printed as an exponent
+// (time ~ N^k) and the curves are written to microbench_curves.csv.
+// When a baseline file exists, any primitive that got slower than the
+// threshold, with its interval clear of the baseline's, is flagged and the
+// run exits with status 1.
+int runMicrobench(int argc, char *argv[], const string &jobFile, const string &resumeFile);
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <vector>
+#include <thread>
+#include "trace.h"
+using namespace std;
+
+// Data-parallel helper shared by bulk import and analytics: the records are
+// split into contiguous slices and each slice runs on its own thread.
+
+// Fewer records than this per thread are not worth a thread
+static const int PARALLEL_MIN_CHUNK = 256;
+
+// Threads used for count records (1 when the batch is small)
+inline int parallelWorkers(int count) {
+    int hardware = (int)thread::hardware_concurrency();
+    if (hardware < 1) hardware = 1;
+    int useful = count / PARALLEL_MIN_CHUNK;
+    if (useful < 1) useful = 1;
+    return useful < hardware ? useful : hardware;
+}
+
+// Run fn(0) .. fn(threads - 1) at once, fn(0) on the calling thread.
+// threadName labels the extra threads in traces.
+template <class Fn>
+void runOnThreads(int threads, const char *threadName, Fn fn) {
+    vector<thread> extra;
+    for (int t = 1; t < threads; ++t) {
+        extra.push_back(thread([fn, t, threadName] {
+            Tracer::nameThread(threadName);
+            fn(t);
+        }));
+    }
+    fn(0);
+    for (size_t i = 0; i < extra.size(); ++i) extra[i].join();
+}
+
+// Call fn(begin, end) on contiguous slices of [0, count), one thread each.
+// fn must only touch the records in its own slice.
+template <class Fn>
+void parallelChunks(int count, const char *threadName, Fn fn) {
+    int workers = parallelWorkers(count);
+    int chunk = (count + workers - 1) / workers;
+    runOnThreads(workers, threadName, [fn, chunk, count](int t) {
+        int begin = t * chunk;
+        int end = (begin + chunk < count) ? begin + chunk : count;
+        if (begin < end) fn(begin, end);
+    });
+}
+
+#endif
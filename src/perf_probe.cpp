@@ -0,0 +1,161 @@
+#include "perf_probe.h"
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+using namespace std;
+using namespace std::chrono;
+
+static string lastError;
+
+const char* PerfProbe::counterName(int counter) {
+    static const char *names[COUNTER_COUNT] = {
+        "cycles", "instructions", "cache_references", "cache_misses",
+        "branches", "branch_misses", "page_faults"
+    };
+    return (counter >= 0 && counter < COUNTER_COUNT) ? names[counter] : "";
+}
+
+string PerfProbe::unavailableReason() {
+    return lastError;
+}
+
+#ifdef __linux__
+// Hardware events join the group led by groupFd (-1: a leader or a lone event)
+static int openCounter(int counter, int groupFd) {
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    switch (counter) {
+        case PerfProbe::CYCLES:           attr.config = PERF_COUNT_HW_CPU_CYCLES; break;
+        case PerfProbe::INSTRUCTIONS:     attr.config = PERF_COUNT_HW_INSTRUCTIONS; break;
+        case PerfProbe::CACHE_REFERENCES: attr.config = PERF_COUNT_HW_CACHE_REFERENCES; break;
+        case PerfProbe::CACHE_MISSES:     attr.config = PERF_COUNT_HW_CACHE_MISSES; break;
+        case PerfProbe::BRANCHES:         attr.config = PERF_COUNT_HW_BRANCH_INSTRUCTIONS; break;
+        case PerfProbe::BRANCH_MISSES:    attr.config = PERF_COUNT_HW_BRANCH_MISSES; break;
+        default:
+            attr.type = PERF_TYPE_SOFTWARE;
+            attr.config = PERF_COUNT_SW_PAGE_FAULTS;
+    }
+    attr.disabled = (groupFd < 0);   // members start and stop with their leader
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    // The group may still be multiplexed with other users' events; read enough to scale
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    if (attr.type == PERF_TYPE_HARDWARE) attr.read_format |= PERF_FORMAT_GROUP | PERF_FORMAT_ID;
+
+    int fd = (int)syscall(__NR_perf_event_open, &attr, 0, -1, groupFd, 0);
+    if (fd < 0 && lastError.empty())
+        lastError = string("perf_event_open: ") + strerror(errno);
+    return fd;
+}
+#endif
+
+PerfProbe::PerfProbe(const string &operation, const string &backend, int iterations,
+                     vector<PerfResult> *resultSink, bool printResult)
+    : sink(resultSink), print(printResult) {
+    result.operation = operation;
+    result.backend = backend;
+    result.iterations = iterations;
+    result.wallMicros = 0;
+    result.countersAvailable = false;
+    for (int c = 0; c < COUNTER_COUNT; ++c) {
+        result.counters[c] = -1;
+        fds[c] = -1;
+        ids[c] = 0;
+    }
+
+#ifdef __linux__
+    fds[CYCLES] = openCounter(CYCLES, -1);
+    if (fds[CYCLES] >= 0)
+        for (int c = INSTRUCTIONS; c < PAGE_FAULTS; ++c) fds[c] = openCounter(c, fds[CYCLES]);
+    fds[PAGE_FAULTS] = openCounter(PAGE_FAULTS, -1);   // software: no counter to share
+    for (int c = 0; c < PAGE_FAULTS; ++c)
+        if (fds[c] >= 0) ioctl(fds[c], PERF_EVENT_IOC_ID, &ids[c]);
+
+    if (fds[CYCLES] >= 0) {
+        ioctl(fds[CYCLES], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(fds[CYCLES], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+    if (fds[PAGE_FAULTS] >= 0) {
+        ioctl(fds[PAGE_FAULTS], PERF_EVENT_IOC_RESET, 0);
+        ioctl(fds[PAGE_FAULTS], PERF_EVENT_IOC_ENABLE, 0);
+    }
+#else
+    lastError = "hardware counters need Linux perf_event_open";
+#endif
+    start = high_resolution_clock::now();
+}
+
+PerfProbe::~PerfProbe() {
+    auto end = high_resolution_clock::now();
+#ifdef __linux__
+    if (fds[CYCLES] >= 0) ioctl(fds[CYCLES], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    if (fds[PAGE_FAULTS] >= 0) ioctl(fds[PAGE_FAULTS], PERF_EVENT_IOC_DISABLE, 0);
+
+    if (fds[CYCLES] >= 0) {
+        // nr, time enabled, time running, then (value, id) per member. The
+        // whole group shares one window, so one scale keeps the ratios exact.
+        unsigned long long group[3 + 2 * COUNTER_COUNT];
+        ssize_t got = read(fds[CYCLES], group, sizeof(group));
+        if (got >= (ssize_t)(3 * sizeof(group[0])) && group[2] > 0) {
+            double scale = (double)group[1] / group[2];
+            for (unsigned long long i = 0; i < group[0] && i < (unsigned long long)COUNTER_COUNT; ++i)
+                for (int c = 0; c < PAGE_FAULTS; ++c)
+                    if (fds[c] >= 0 && ids[c] == group[4 + 2 * i])
+                        result.counters[c] = (long long)(group[3 + 2 * i] * scale);
+            result.countersAvailable = true;
+        }
+    }
+    if (fds[PAGE_FAULTS] >= 0) {
+        unsigned long long values[3];   // value, time enabled, time running
+        if (read(fds[PAGE_FAULTS], values, sizeof(values)) == (ssize_t)sizeof(values) && values[2] > 0) {
+            result.counters[PAGE_FAULTS] = (long long)(values[0] * ((double)values[1] / values[2]));
+            result.countersAvailable = true;
+        }
+    }
+    for (int c = COUNTER_COUNT - 1; c >= 0; --c)   // members before their leader
+        if (fds[c] >= 0) close(fds[c]);
+#endif
+    result.wallMicros = (double)duration_cast<microseconds>(end - start).count();
+
+    if (print) printPerfResult(result);
+    if (sink) sink->push_back(result);
+}
+
+// ---------------- derived ratios ----------------
+double perfIPC(const PerfResult &r) {
+    if (r.counters[PerfProbe::CYCLES] <= 0 || r.counters[PerfProbe::INSTRUCTIONS] < 0) return -1;
+    return (double)r.counters[PerfProbe::INSTRUCTIONS] / r.counters[PerfProbe::CYCLES];
+}
+
+double perfCacheMissRate(const PerfResult &r) {
+    if (r.counters[PerfProbe::CACHE_REFERENCES] <= 0 || r.counters[PerfProbe::CACHE_MISSES] < 0) return -1;
+    return (double)r.counters[PerfProbe::CACHE_MISSES] / r.counters[PerfProbe::CACHE_REFERENCES];
+}
+
+double perfBranchMissRate(const PerfResult &r) {
+    if (r.counters[PerfProbe::BRANCHES] <= 0 || r.counters[PerfProbe::BRANCH_MISSES] < 0) return -1;
+    return (double)r.counters[PerfProbe::BRANCH_MISSES] / r.counters[PerfProbe::BRANCHES];
+}
+
+void printPerfResult(const PerfResult &r) {
+    cout << "[Counters] " << r.operation << " (" << r.backend << "): "
+         << (long long)r.wallMicros << " microseconds";
+    if (!r.countersAvailable) {
+        cout << ", counters unavailable (" << PerfProbe::unavailableReason() << ")\n";
+        return;
+    }
+    if (r.counters[PerfProbe::CYCLES] >= 0) cout << ", " << r.counters[PerfProbe::CYCLES] << " cycles";
+    if (perfIPC(r) >= 0) cout << ", IPC " << perfIPC(r);
+    if (perfCacheMissRate(r) >= 0) cout << ", cache miss " << perfCacheMissRate(r) * 100 << "%";
+    if (perfBranchMissRate(r) >= 0) cout << ", branch miss " << perfBranchMissRate(r) * 100 << "%";
+    if (r.counters[PerfProbe::PAGE_FAULTS] >= 0) cout << ", " << r.counters[PerfProbe::PAGE_FAULTS] << " page faults";
+    cout << "\n";
+}
@@ -0,0 +1,69 @@
+#ifndef PERF_PROBE_H
+#define PERF_PROBE_H
+
+#include <string>
+#include <vector>
+#include <chrono>
+using namespace std;
+
+// Hardware/software counters for one measured operation
+struct PerfResult {
+    string operation;             // load, match, sort, search, delete, ...
+    string backend;               // "Linked List", "Array", ...
+    int iterations;               // repetitions covered by the measurement
+    double wallMicros;
+    bool countersAvailable;       // false when perf_event_open is not usable
+    long long counters[7];        // indexed by PerfProbe::Counter, -1 if missing
+};
+
+// Scoped (RAII) probe: counting starts in the constructor and stops in the
+// destructor, which appends a PerfResult to the sink and prints a
+// "[Counters]" line. Wrap any block to measure it:
+//
+//     {
+//         PerfProbe probe("match", "Array", 50, &results);
+//         ... operation ...
+//     }
+//
+// On Linux the counters come from perf_event_open (user space only, so it
+// works with perf_event_paranoid <= 2). The hardware events form one group
+// led by cycles, so they are scheduled together and IPC and the miss rates
+// are ratios over the same time window; an event the PMU cannot fit into
+// the group is left out. Elsewhere, or when the kernel refuses, only
+// wall-clock time is recorded.
+class PerfProbe {
+public:
+    enum Counter {
+        CYCLES, INSTRUCTIONS, CACHE_REFERENCES, CACHE_MISSES,
+        BRANCHES, BRANCH_MISSES, PAGE_FAULTS, COUNTER_COUNT
+    };
+    static const char* counterName(int counter);
+
+private:
+    PerfResult result;
+    vector<PerfResult> *sink;
+    bool print;
+    int fds[COUNTER_COUNT];
+    unsigned long long ids[COUNTER_COUNT];   // kernel event IDs, to find each value in a group read
+    chrono::high_resolution_clock::time_point start;
+
+    PerfProbe(const PerfProbe&);
+    PerfProbe& operator=(const PerfProbe&);
+
+public:
+    PerfProbe(const string &operation, const string &backend, int iterations = 1,
+              vector<PerfResult> *sink = nullptr, bool print = true);
+    ~PerfProbe();
+
+    // Why counters are missing (empty when they work)
+    static string unavailableReason();
+};
+
+void printPerfResult(const PerfResult &r);
+
+// Derived ratios, or -1 when a counter is missing
+double perfIPC(const PerfResult &r);
+double perfCacheMissRate(const PerfResult &r);
+double perfBranchMissRate(const PerfResult &r);
+
+#endif
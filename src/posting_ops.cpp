@@ -0,0 +1,131 @@
+#include "posting_ops.h"
+#include <algorithm>
+using namespace std;
+
+// A list this many times longer than the other is probed by galloping
+// instead of walked element by element.
+static const size_t GALLOP_RATIO = 16;
+
+// ---------------- gallop ----------------
+// First index i in [lo, n) with data[i] >= target, probing 1, 2, 4, ... ahead
+static size_t gallop(const int *data, size_t lo, size_t n, int target) {
+    if (lo >= n || data[lo] >= target) return lo;
+    size_t step = 1;
+    size_t prev = lo;
+    size_t probe = lo + 1;
+    while (probe < n && data[probe] < target) {
+        prev = probe;
+        step <<= 1;
+        probe = lo + step;
+    }
+    if (probe > n) probe = n;
+    return lower_bound(data + prev + 1, data + probe, target) - data;
+}
+
+// ---------------- intersection ----------------
+template <class Emit>
+static void intersectImpl(const PostingList &x, const PostingList &y, Emit emit) {
+    const PostingList &small = (x.size() <= y.size()) ? x : y;
+    const PostingList &large = (x.size() <= y.size()) ? y : x;
+    if (small.empty()) return;
+
+    const int *s = small.data();
+    const int *l = large.data();
+    size_t ns = small.size(), nl = large.size();
+
+    if (nl / ns >= GALLOP_RATIO) {
+        size_t j = 0;
+        for (size_t i = 0; i < ns && j < nl; ++i) {
+            j = gallop(l, j, nl, s[i]);
+            if (j < nl && l[j] == s[i]) emit(s[i]);
+        }
+        return;
+    }
+
+    size_t i = 0, j = 0;
+    while (i < ns && j < nl) {
+        if (s[i] < l[j]) ++i;
+        else if (s[i] > l[j]) ++j;
+        else { emit(s[i]); ++i; ++j; }
+    }
+}
+
+void intersectPostings(const PostingList &a, const PostingList &b, PostingList &out) {
+    out.clear();
+    out.reserve(min(a.size(), b.size()));
+    intersectImpl(a, b, [&out](int id) { out.push_back(id); });
+}
+
+size_t intersectCount(const PostingList &a, const PostingList &b) {
+    size_t n = 0;
+    intersectImpl(a, b, [&n](int) { ++n; });
+    return n;
+}
+
+// ---------------- union ----------------
+template <class Emit>
+static void unionImpl(const PostingList &a, const PostingList &b, Emit emit) {
+    size_t i = 0, j = 0;
+    while (i < a.size() && j < b.size()) {
+        if (a[i] < b[j]) emit(a[i++]);
+        else if (a[i] > b[j]) emit(b[j++]);
+        else { emit(a[i]); ++i; ++j; }
+    }
+    while (i < a.size()) emit(a[i++]);
+    while (j < b.size()) emit(b[j++]);
+}
+
+void unionPostings(const PostingList &a, const PostingList &b, PostingList &out) {
+    out.clear();
+    out.reserve(a.size() + b.size());
+    unionImpl(a, b, [&out](int id) { out.push_back(id); });
+}
+
+size_t unionCount(const PostingList &a, const PostingList &b) {
+    return a.size() + b.size() - intersectCount(a, b);
+}
+
+// ---------------- difference ----------------
+template <class Emit>
+static void differenceImpl(const PostingList &a, const PostingList &b, Emit emit) {
+    const int *l = b.data();
+    size_t nl = b.size();
+    bool gallopB = !a.empty() && nl / a.size() >= GALLOP_RATIO;
+
+    size_t j = 0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (gallopB) j = gallop(l, j, nl, a[i]);
+        else while (j < nl && l[j] < a[i]) ++j;
+        if (j < nl && l[j] == a[i]) continue;
+        emit(a[i]);
+    }
+}
+
+void differencePostings(const PostingList &a, const PostingList &b, PostingList &out) {
+    out.clear();
+    out.reserve(a.size());
+    differenceImpl(a, b, [&out](int id) { out.push_back(id); });
+}
+
+size_t differenceCount(const PostingList &a, const PostingList &b) {
+    return a.size() - intersectCount(a, b);
+}
+
+// ---------------- maintenance ----------------
+void postingInsert(PostingList &list, int id) {
+    if (list.empty() || list.back() < id) {
+        list.push_back(id);
+        return;
+    }
+    PostingList::iterator it = lower_bound(list.begin(), list.end(), id);
+    if (it == list.end() || *it != id) list.insert(it, id);
+}
+
+void postingErase(PostingList &list, int id) {
+    PostingList::iterator it = lower_bound(list.begin(), list.end(), id);
+    if (it != list.end() && *it == id) list.erase(it);
+}
+
+bool postingContains(const PostingList &list, int id) {
+    return binary_search(list.begin(), list.end(), id);
+}
@@ -0,0 +1,28 @@
+#ifndef POSTING_OPS_H
+#define POSTING_OPS_H
+
+#include <vector>
+#include <cstddef>
+using namespace std;
+
+// A posting list is a strictly increasing list of record IDs.
+typedef vector<int> PostingList;
+
+// Set operations on posting lists. Intersection switches to galloping
+// (exponential) search when one list is much shorter than the other, so
+// "rare skill AND common skill" costs O(small * log(large)).
+void intersectPostings(const PostingList &a, const PostingList &b, PostingList &out);
+void unionPostings(const PostingList &a, const PostingList &b, PostingList &out);
+void differencePostings(const PostingList &a, const PostingList &b, PostingList &out);  // a \ b
+
+// Count-only variants: same cost, nothing is written
+size_t intersectCount(const PostingList &a, const PostingList &b);
+size_t unionCount(const PostingList &a, const PostingList &b);
+size_t differenceCount(const PostingList &a, const PostingList &b);
+
+// Insert/erase keeping the list sorted (O(1) for the common append case)
+void postingInsert(PostingList &list, int id);
+void postingErase(PostingList &list, int id);
+bool postingContains(const PostingList &list, int id);
+
+#endif
@@ -0,0 +1,110 @@
+#include "query_arena.h"
+#include "metrics.h"
+#include "memory_accounting.h"
+#include <iostream>
+#include <atomic>
+using namespace std;
+
+static atomic<long long> largestPeak(0);
+static atomic<long long> overCap(0);      // queries whose peak did not fit under the cap
+
+QueryArena::QueryArena()
+    : buffer(nullptr), capacity(0), used(0), spillBytes(0), cap(DEFAULT_CAP), depth(0), peak(0), highWater(0) {}
+
+QueryArena::~QueryArena() {
+    for (size_t i = 0; i < spill.size(); ++i) ::operator delete(spill[i]);
+    ::operator delete(buffer);
+}
+
+QueryArena& QueryArena::local() {
+    static thread_local QueryArena arena;
+    return arena;
+}
+
+// ---------------- allocation ----------------
+void* QueryArena::allocate(size_t bytes, size_t align) {
+    if (bytes == 0) bytes = 1;
+    size_t offset = (used + align - 1) & ~(align - 1);
+    if (buffer && offset + bytes <= capacity) {
+        used = offset + bytes;
+        if (used + spillBytes > peak) peak = used + spillBytes;
+        return buffer + offset;
+    }
+
+    // Does not fit: a chunk of its own until end() resizes the buffer
+    char *chunk = (char*)::operator new(bytes);   // operator new aligns for any type
+    spill.push_back(chunk);
+    spillSizes.push_back(bytes);
+    spillBytes += bytes;
+    if (used + spillBytes > peak) peak = used + spillBytes;
+    return chunk;
+}
+
+bool QueryArena::owns(const void *p) const {
+    const char *c = (const char*)p;
+    if (buffer && c >= buffer && c < buffer + capacity) return true;
+    for (size_t i = 0; i < spill.size(); ++i)
+        if (c >= spill[i] && c < spill[i] + spillSizes[i]) return true;
+    return false;
+}
+
+// ---------------- query boundaries ----------------
+void QueryArena::begin() {
+    if (depth++ > 0) return;
+    if (!buffer) {
+        capacity = INITIAL_BYTES < cap ? INITIAL_BYTES : cap;
+        buffer = (char*)::operator new(capacity);
+    }
+    used = 0;
+    peak = 0;
+}
+
+size_t QueryArena::end() {
+    if (depth == 0 || --depth > 0) return peak;
+
+    for (size_t i = 0; i < spill.size(); ++i) ::operator delete(spill[i]);
+    spill.clear();
+    spillSizes.clear();
+    spillBytes = 0;
+    used = 0;
+
+    // Grow once to what this query needed so the next one does not spill
+    if (peak > capacity) {
+        size_t wanted = peak + peak / 4;
+        if (wanted > cap) wanted = cap;
+        if (wanted > capacity) {
+            ::operator delete(buffer);
+            buffer = (char*)::operator new(wanted);
+            capacity = wanted;
+        }
+        if (peak > cap) overCap++;
+    }
+
+    if (peak > highWater) highWater = peak;
+    long long seen = largestPeak.load(memory_order_relaxed);
+    while ((long long)peak > seen && !largestPeak.compare_exchange_weak(seen, (long long)peak, memory_order_relaxed)) {}
+    return peak;
+}
+
+void QueryArena::printReport() {
+    QueryArena &arena = local();
+    cout << "Query arena: " << arena.bufferBytes() / 1024 << " KB warm buffer on this thread (cap "
+         << arena.cap / (1024 * 1024) << " MB), largest query " << largestPeak.load() / 1024 << " KB";
+    if (overCap.load()) cout << ", " << overCap.load() << " queries over the cap";
+    cout << "\n";
+}
+
+// ---------------- QueryScope ----------------
+QueryScope::QueryScope(const char *backendName)
+    : backend(backendName), allocationsAtStart(MemoryAccounting::allocationCount()) {
+    QueryArena::local().begin();
+}
+
+QueryScope::~QueryScope() {
+    QueryArena &arena = QueryArena::local();
+    size_t peak = arena.end();
+    if (arena.active()) return;
+    long long allocations = MemoryAccounting::allocationCount() - allocationsAtStart;
+    MetricsRegistry::instance().histogram("arena_peak_kb", backend).record((long long)(peak / 1024));
+    MetricsRegistry::instance().histogram("query_heap_allocs", backend).record(allocations);
+}
@@ -0,0 +1,102 @@
+#ifndef QUERY_ARENA_H
+#define QUERY_ARENA_H
+
+#include <cstddef>
+#include <new>
+#include <vector>
+using namespace std;
+
+// Per-thread monotonic arena for the scratch data of one query (result
+// arrays, ranking buckets, score tiles). Allocation is a pointer bump into
+// one warm buffer and nothing is freed until the query ends, when the whole
+// buffer is reset at once. A query that does not fit spills into extra
+// chunks from the global allocator; at the end they are freed and the
+// buffer grows to the query's peak, up to the cap, so the next query of the
+// same size stays inside it. The buffer is never handed back, so server and
+// batch modes reuse it across queries.
+//
+// The cap bounds only that retained buffer, not a single query: a query
+// larger than the cap still gets its memory from spill chunks (freed at its
+// end) rather than failing, and is counted as an overrun in printReport().
+//
+// Only trivially destructible data belongs here: nothing is destroyed.
+class QueryArena {
+public:
+    static const size_t DEFAULT_CAP = 64 << 20;    // largest buffer kept between queries (not a per-query limit)
+    static const size_t INITIAL_BYTES = 256 << 10;
+
+private:
+    char *buffer;
+    size_t capacity;
+    size_t used;
+    vector<char*> spill;                 // chunks of the current query that did not fit
+    vector<size_t> spillSizes;
+    size_t spillBytes;
+    size_t cap;
+    int depth;                           // nested QueryScopes
+    size_t peak;                         // this query
+    size_t highWater;                    // any query on this thread
+
+    QueryArena();
+    ~QueryArena();
+    QueryArena(const QueryArena &);      // not copyable
+    QueryArena& operator=(const QueryArena &);
+
+public:
+    static QueryArena& local();          // this thread's arena
+
+    bool active() const { return depth > 0; }
+    void* allocate(size_t bytes, size_t align = alignof(max_align_t));
+    bool owns(const void *p) const;
+
+    template <class T>
+    T* allocateArray(size_t n) { return (T*)allocate(n * sizeof(T), alignof(T)); }
+
+    void begin();
+    size_t end();                        // returns the query's peak bytes
+
+    void setCap(size_t bytes) { cap = bytes; }
+    size_t bufferBytes() const { return capacity; }
+    size_t highWaterBytes() const { return highWater; }
+
+    // Highest query peak and cap overruns over every thread
+    static void printReport();
+};
+
+// Opens a query on this thread's arena. The outermost scope resets it and
+// records two metrics under the given backend: "arena_peak_kb" and
+// "query_heap_allocs", the global allocator calls made meanwhile (0 once
+// the arena and node pool are warm).
+class QueryScope {
+private:
+    const char *backend;
+    long long allocationsAtStart;
+
+public:
+    explicit QueryScope(const char *backendName);
+    ~QueryScope();
+};
+
+// STL allocator over the current query's arena (global heap outside a query)
+template <class T>
+class ArenaAllocator {
+public:
+    typedef T value_type;
+
+    ArenaAllocator() {}
+    template <class U> ArenaAllocator(const ArenaAllocator<U> &) {}
+
+    T* allocate(size_t n) {
+        QueryArena &arena = QueryArena::local();
+        if (arena.active()) return arena.allocateArray<T>(n);
+        return (T*)::operator new(n * sizeof(T));
+    }
+    void deallocate(T *p, size_t) {
+        if (!QueryArena::local().owns(p)) ::operator delete(p);   // arena memory goes at end()
+    }
+
+    template <class U> bool operator==(const ArenaAllocator<U> &) const { return true; }
+    template <class U> bool operator!=(const ArenaAllocator<U> &) const { return false; }
+};
+
+#endif
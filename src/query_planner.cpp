@@ -0,0 +1,131 @@
+#include "query_planner.h"
+#include "metrics.h"
+#include <iostream>
+#include <iomanip>
+using namespace std;
+using namespace std::chrono;
+
+static const double SMOOTHING = 0.3;   // weight of the newest measurement
+
+QueryPlanner& QueryPlanner::instance() {
+    static QueryPlanner planner;
+    return planner;
+}
+
+const char* QueryPlanner::backendName(int backend) {
+    return backend == 0 ? "Linked List" : "Array";
+}
+
+// ---------------- planning ----------------
+QueryPlanner::Plan QueryPlanner::choose(const string &operation) {
+    lock_guard<mutex> guard(lock);
+    map<string, Operation>::iterator it = operations.find(operation);
+    if (it == operations.end()) {
+        Operation fresh = { { { 0, 0 }, { 0, 0 } }, 0 };
+        it = operations.insert(make_pair(operation, fresh)).first;
+    }
+    Operation &op = it->second;
+
+    Plan plan;
+    plan.operation = operation;
+    for (int b = 0; b < BACKENDS; ++b) {
+        plan.runs[b] = op.cost[b].runs;
+        plan.estimate[b] = op.cost[b].runs ? op.cost[b].average : -1;
+    }
+
+    int cheapest = (op.cost[1].average <= op.cost[0].average) ? 1 : 0;
+    if (op.cost[0].runs < MIN_RUNS || op.cost[1].runs < MIN_RUNS) {
+        plan.backend = (op.cost[1].runs <= op.cost[0].runs) ? 1 : 0;   // fewest runs, the array on a tie
+        plan.reason = "measuring";
+    } else if (++op.decisions % RECHECK_EVERY == 0) {
+        plan.backend = 1 - cheapest;
+        plan.reason = "re-checking";
+    } else {
+        plan.backend = cheapest;
+        plan.reason = "cheapest";
+    }
+    return plan;
+}
+
+void QueryPlanner::observe(const string &operation, int backend, long long micros) {
+    lock_guard<mutex> guard(lock);
+    Cost &cost = operations[operation].cost[backend];
+    cost.average = cost.runs ? (1 - SMOOTHING) * cost.average + SMOOTHING * micros : (double)micros;
+    cost.runs++;
+}
+
+// ---------------- output ----------------
+static void printEstimate(const QueryPlanner::Plan &plan, int backend) {
+    cout << QueryPlanner::backendName(backend) << " ";
+    if (plan.estimate[backend] < 0) cout << "(no runs)";
+    else cout << (long long)plan.estimate[backend] << " us (" << plan.runs[backend] << " runs)";
+}
+
+void QueryPlanner::explain(const Plan &plan) {
+    cout << "EXPLAIN " << plan.operation << ": " << backendName(plan.backend) << " [" << plan.reason << "]; estimates ";
+    printEstimate(plan, 0);
+    cout << ", ";
+    printEstimate(plan, 1);
+    cout << "\n";
+}
+
+void QueryPlanner::printReport() const {
+    lock_guard<mutex> guard(lock);
+    if (operations.empty()) {
+        cout << "Planner: no automatic requests yet.\n";
+        return;
+    }
+    cout << "Planner estimates (microseconds, moving average):\n";
+    cout << left << setw(18) << "operation" << right << setw(14) << "Linked List" << setw(14) << "Array" << "  choice\n";
+    for (map<string, Operation>::const_iterator it = operations.begin(); it != operations.end(); ++it) {
+        const Cost *cost = it->second.cost;
+        cout << left << setw(18) << it->first << right;
+        for (int b = 0; b < BACKENDS; ++b) {
+            if (cost[b].runs) cout << setw(14) << (long long)cost[b].average;
+            else cout << setw(14) << "-";
+        }
+        if (cost[0].runs && cost[1].runs) cout << "  " << backendName(cost[1].average <= cost[0].average ? 1 : 0);
+        cout << "\n";
+    }
+}
+
+// ---------------- PlannedQuery ----------------
+PlannedQuery::PlannedQuery(const string &operation, const char *const *metricNames, bool explainPlan)
+    : plan(QueryPlanner::instance().choose(operation)), metrics(metricNames), explain(explainPlan) {
+    if (explain) QueryPlanner::explain(plan);
+    metricsAtStart = metricTotal();
+    samplesAtStart = metricSamples();
+    start = steady_clock::now();
+}
+
+long long PlannedQuery::metricTotal() const {
+    long long total = 0;
+    for (const char *const *m = metrics; m && *m; ++m)
+        total += MetricsRegistry::instance().totalMicros(*m, QueryPlanner::backendName(plan.backend));
+    return total;
+}
+
+long long PlannedQuery::metricSamples() const {
+    long long samples = 0;
+    for (const char *const *m = metrics; m && *m; ++m)
+        samples += MetricsRegistry::instance().sampleCount(*m, QueryPlanner::backendName(plan.backend));
+    return samples;
+}
+
+PlannedQuery::~PlannedQuery() {
+    if (metrics && metricSamples() == samplesAtStart) {
+        if (explain) cout << "EXPLAIN " << plan.operation << ": ended early, not measured\n";
+        return;
+    }
+    long long actual = metrics ? metricTotal() - metricsAtStart
+                               : duration_cast<microseconds>(steady_clock::now() - start).count();
+    QueryPlanner::instance().observe(plan.operation, plan.backend, actual);
+    if (!explain) return;
+
+    cout << "EXPLAIN " << plan.operation << " actual: " << actual << " us on " << QueryPlanner::backendName(plan.backend);
+    double estimate = plan.estimate[plan.backend];
+    if (estimate > 0)
+        cout << " (estimated " << (long long)estimate << " us, " << showpos
+             << (long long)((actual - estimate) * 100 / estimate) << noshowpos << "%)";
+    cout << "\n";
+}
@@ -0,0 +1,90 @@
+#ifndef QUERY_PLANNER_H
+#define QUERY_PLANNER_H
+
+#include <string>
+#include <map>
+#include <mutex>
+#include <chrono>
+using namespace std;
+
+// Cost-based choice between the linked list and the array for read
+// operations, so "which structure is faster" never has to be answered by
+// hand. For every (operation, backend) the planner keeps an exponentially
+// weighted moving average of the measured cost in microseconds. A request
+// goes to the backend with the lower estimate; a backend that has run an
+// operation fewer than MIN_RUNS times is tried first, and every RECHECK_EVERY
+// decisions the other one is run again so the estimates follow the workload
+// (store sizes change with imports and purges).
+class QueryPlanner {
+public:
+    static const int BACKENDS = 2;           // 0 = Linked List, 1 = Array
+    static const int MIN_RUNS = 2;
+    static const int RECHECK_EVERY = 16;
+
+    struct Plan {
+        string operation;
+        int backend;
+        double estimate[BACKENDS];           // microseconds, < 0 while unknown
+        int runs[BACKENDS];
+        const char *reason;
+    };
+
+private:
+    struct Cost {
+        double average;
+        int runs;
+    };
+    struct Operation {
+        Cost cost[BACKENDS];
+        int decisions;
+    };
+
+    map<string, Operation> operations;
+    mutable mutex lock;
+
+    QueryPlanner() {}
+    QueryPlanner(const QueryPlanner&);
+    QueryPlanner& operator=(const QueryPlanner&);
+
+public:
+    static QueryPlanner& instance();
+    static const char* backendName(int backend);
+
+    Plan choose(const string &operation);
+    void observe(const string &operation, int backend, long long micros);
+
+    // One line per plan: chosen backend, why, and both estimates
+    static void explain(const Plan &plan);
+
+    // Every operation's estimates and which backend currently wins
+    void printReport() const;
+};
+
+// One planned request. The constructor picks the backend (and prints the
+// plan when explain is set); the destructor measures what the request
+// actually cost, feeds it back to the planner and, with explain, prints the
+// estimate next to the actual. The cost is the growth of the given latency
+// metrics for the chosen backend, so time spent waiting at a prompt is not
+// counted; with no metrics (nullptr) it is the wall-clock time. A request
+// that recorded none of its metrics (unknown ID, bad input) ended early and
+// is not fed back, so it cannot make its backend look free.
+class PlannedQuery {
+private:
+    QueryPlanner::Plan plan;
+    const char *const *metrics;              // nullptr-terminated list, or nullptr
+    bool explain;
+    long long metricsAtStart;
+    long long samplesAtStart;
+    chrono::steady_clock::time_point start;
+
+    long long metricTotal() const;
+    long long metricSamples() const;
+
+public:
+    PlannedQuery(const string &operation, const char *const *metricNames, bool explainPlan);
+    ~PlannedQuery();
+
+    int backend() const { return plan.backend; }
+};
+
+#endif
@@ -0,0 +1,140 @@
+#include "record_filter.h"
+#include "duplicate_detector.h"
+#include "metrics.h"
+#include "utility.h"
+#include "skill_ontology.h"
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <climits>
+using namespace std;
+
+// ---------------- skill ----------------
+// An alias ("ML") selects the canonical keyword the records store
+HasSkillPredicate::HasSkillPredicate(const string &skill) : skill(lowercase(SkillOntology::canonical(skill))) {}
+
+bool HasSkillPredicate::matches(int, const string &, const PackedText &, const string keywords[10]) const {
+    for (int i = 0; i < 10; ++i) {
+        const string &k = keywords[i];
+        if (k.size() != skill.size()) continue;
+        bool same = true;
+        for (size_t c = 0; c < k.size() && same; ++c)
+            same = tolower((unsigned char)k[c]) == skill[c];
+        if (same) return true;
+    }
+    return false;
+}
+
+string HasSkillPredicate::describe() const {
+    return "skill \"" + skill + "\"";
+}
+
+// ---------------- IDs ----------------
+IDSetPredicate::IDSetPredicate(const vector<Range> &list) {
+    // Sort and merge, so a lookup is one binary search
+    vector<Range> sorted = list;
+    sort(sorted.begin(), sorted.end());
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        if (!ranges.empty() && (long long)sorted[i].first <= (long long)ranges.back().second + 1)
+            ranges.back().second = max(ranges.back().second, sorted[i].second);
+        else
+            ranges.push_back(sorted[i]);
+    }
+}
+
+bool IDSetPredicate::matches(int id, const string &, const PackedText &, const string[10]) const {
+    // First range starting after id; the one before it is the only candidate
+    vector<Range>::const_iterator it = upper_bound(ranges.begin(), ranges.end(), Range(id, INT_MAX));
+    return it != ranges.begin() && id <= (it - 1)->second;
+}
+
+string IDSetPredicate::describe() const {
+    long long count = 0;
+    for (size_t i = 0; i < ranges.size(); ++i) count += (long long)ranges[i].second - ranges[i].first + 1;
+    ostringstream out;
+    out << count << " listed ID(s)";
+    return out.str();
+}
+
+// ---------------- text ----------------
+TextContainsPredicate::TextContainsPredicate(const string &text) : text(lowercase(text)) {}
+
+bool TextContainsPredicate::matches(int, const string &, const PackedText &packed, const string[10]) const {
+    const string description = packed.str();
+    return search(description.begin(), description.end(), text.begin(), text.end(),
+                  [](char a, char b) { return tolower((unsigned char)a) == b; }) != description.end();
+}
+
+string TextContainsPredicate::describe() const {
+    return "text \"" + text + "\"";
+}
+
+// ---------------- duplicates ----------------
+bool DuplicatePredicate::matches(int id, const string &, const PackedText &, const string[10]) const {
+    vector<DuplicateDetector::Candidate> dups = detector.findDuplicates(id);
+    for (size_t i = 0; i < dups.size(); ++i)
+        if (dups[i].id < id) return true;
+    return false;
+}
+
+string DuplicatePredicate::describe() const {
+    return "near-duplicates of older records";
+}
+
+// ---------------- parsing ----------------
+// "1,5,10-20" -> [1,1] [5,5] [10,20]; IDs must fit in an int
+static bool parseIDs(const string &list, vector<IDSetPredicate::Range> &ids) {
+    stringstream ss(list);
+    string part;
+    while (getline(ss, part, ',')) {
+        part = trimmed(part);
+        if (part.empty()) continue;
+        char *rest;
+        long first = strtol(part.c_str(), &rest, 10);
+        long last = first;
+        if (*rest == '-') last = strtol(rest + 1, &rest, 10);
+        if (*rest != '\0' || first < 1 || last < first || last > INT_MAX) return false;
+        ids.push_back(IDSetPredicate::Range((int)first, (int)last));
+    }
+    return !ids.empty();
+}
+
+RecordPredicate* makePredicate(const string &kind, const string &argument,
+                               const DuplicateDetector *duplicates) {
+    string arg = trimmed(argument);
+    if (kind == "duplicates") {
+        if (!duplicates) {
+            cout << "No duplicate detector for this store.\n";
+            return nullptr;
+        }
+        return new DuplicatePredicate(*duplicates);
+    }
+    if (kind != "skill" && kind != "ids" && kind != "text") {
+        cout << "Unknown filter \"" << kind << "\" (use skill, ids, text or duplicates).\n";
+        return nullptr;
+    }
+    if (arg.empty()) {
+        cout << "Filter \"" << kind << "\" needs a value.\n";
+        return nullptr;
+    }
+    if (kind == "skill") return new HasSkillPredicate(arg);
+    if (kind == "text") return new TextContainsPredicate(arg);
+
+    vector<IDSetPredicate::Range> ids;
+    if (!parseIDs(arg, ids)) {
+        cout << "Bad ID list \"" << arg << "\" (e.g. 3,7,100-250).\n";
+        return nullptr;
+    }
+    return new IDSetPredicate(ids);
+}
+
+// ---------------- report ----------------
+void reportBulkDelete(const string &store, const char *backend, const RecordPredicate &predicate,
+                      int removed, int remaining, long long micros) {
+    cout << "Removed " << removed << " record(s) matching " << predicate.describe() << " from "
+         << store << " (" << remaining << " left)\n";
+    cout << "[Performance] removeWhere [" << store << "] execution time: " << micros << " microseconds\n";
+    recordLatency("bulk_delete", backend, micros);
+}
@@ -0,0 +1,86 @@
+#ifndef RECORD_FILTER_H
+#define RECORD_FILTER_H
+
+#include <string>
+#include <vector>
+#include <utility>
+#include "text_codec.h"
+using namespace std;
+
+class DuplicateDetector;
+
+// Selects the records a bulk delete (removeWhere) takes out. A predicate sees
+// the same fields a RecordListener does, so one predicate works on all four
+// containers; title is empty for resumes. The description is passed still
+// packed so only predicates that read it pay for decoding.
+class RecordPredicate {
+public:
+    virtual ~RecordPredicate() {}
+    virtual bool matches(int id, const string &title, const PackedText &description,
+                         const string keywords[10]) const = 0;
+    virtual string describe() const = 0;
+};
+
+// Lists the skill among its keywords (case-insensitive)
+class HasSkillPredicate : public RecordPredicate {
+private:
+    string skill;   // lowercase
+
+public:
+    explicit HasSkillPredicate(const string &skill);
+    bool matches(int id, const string &title, const PackedText &description, const string keywords[10]) const;
+    string describe() const;
+};
+
+// ID falls in one of a list of ranges, kept as (first, last) pairs so
+// "1-2000000000" costs two ints rather than a set of every ID
+class IDSetPredicate : public RecordPredicate {
+public:
+    typedef pair<int, int> Range;    // first, last (inclusive)
+
+private:
+    vector<Range> ranges;            // sorted, non-overlapping
+
+public:
+    explicit IDSetPredicate(const vector<Range> &ranges);
+    bool matches(int id, const string &title, const PackedText &description, const string keywords[10]) const;
+    string describe() const;
+};
+
+// Description contains the text (case-insensitive)
+class TextContainsPredicate : public RecordPredicate {
+private:
+    string text;    // lowercase
+
+public:
+    explicit TextContainsPredicate(const string &text);
+    bool matches(int id, const string &title, const PackedText &description, const string keywords[10]) const;
+    string describe() const;
+};
+
+// Near-duplicate of a record with a smaller ID that is still stored, so the
+// oldest copy of every cluster survives. The detector must be a listener of
+// the same container: the removal pass visits records in ID order and tells
+// the detector about each removal, so "still stored" holds as it goes.
+class DuplicatePredicate : public RecordPredicate {
+private:
+    const DuplicateDetector &detector;
+
+public:
+    explicit DuplicatePredicate(const DuplicateDetector &detector) : detector(detector) {}
+    bool matches(int id, const string &title, const PackedText &description, const string keywords[10]) const;
+    string describe() const;
+};
+
+// Builds a predicate from a kind and its argument:
+//   skill <name> | ids <1,5,10-20> | text <words> | duplicates
+// Returns nullptr (after printing why) for an unknown kind, a bad argument,
+// or "duplicates" without a detector. The caller deletes the result.
+RecordPredicate* makePredicate(const string &kind, const string &argument,
+                               const DuplicateDetector *duplicates);
+
+// Prints the outcome of a removeWhere() and records its "bulk_delete" latency
+void reportBulkDelete(const string &store, const char *backend, const RecordPredicate &predicate,
+                      int removed, int remaining, long long micros);
+
+#endif
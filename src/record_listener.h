@@ -0,0 +1,31 @@
+#ifndef RECORD_LISTENER_H
+#define RECORD_LISTENER_H
+
+#include <string>
+using namespace std;
+
+// Secondary structures (indexes, caches) register with a job/resume container
+// and are told about every record that enters or leaves it, so they never
+// have to rescan the whole store.
+class RecordListener {
+public:
+    virtual ~RecordListener() {}
+
+    // title is empty for resumes; keywords always points at 10 slots
+    virtual void onInsert(int id, const string &title, const string &description,
+                          const string keywords[10]) = 0;
+    virtual void onRemove(int id, const string &title, const string &description,
+                          const string keywords[10]) = 0;
+    virtual void onClear() = 0;
+
+    // True when more than one container feeds this listener (one completer
+    // for jobs and resumes). A container emptying itself then reports
+    // onRemove for each of its own records instead of onClear, which would
+    // also wipe what the other containers fed it.
+    virtual bool sharedBetweenStores() const { return false; }
+
+    // Called once after a bulk import has reported all of its inserts
+    virtual void onBatchEnd() {}
+};
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef RECORD_STORE_H
+#define RECORD_STORE_H
+
+#include <cstddef>
+#include <iterator>
+
+// Common contract of the job and resume containers. The matchers in
+// matching.h are templates over it, so every backend gets its own fully
+// inlined copy of each algorithm with no virtual calls. A store provides:
+//
+//   typedef ... record_type;             Job / JobNode / Resume / ResumeNode
+//   typedef ... const_iterator;          forward iterator over record_type
+//   const_iterator begin() const, end() const;   records in ascending ID order
+//   int size() const;
+//   const record_type* findByID(int id) const;   nullptr if absent
+//   static const bool INDEXED_LOOKUP;    true when findByID is O(log N)
+//   static const char* backendName();    label used in printed output
+//
+// Job records have jobID, title, description and keywords[10]; resume
+// records have resumeID, description and keywords[10].
+// Adding a backend (columnar, sharded, mmapped, ...) means implementing
+// this contract, plus a MatchResultsFor specialization if its results
+// should not be kept in a plain array.
+
+// Forward iterator over a singly linked list of nodes with a next pointer
+template <class Node>
+class NodeIterator {
+private:
+    const Node *node;
+
+public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef Node value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const Node* pointer;
+    typedef const Node& reference;
+
+    explicit NodeIterator(const Node *start = nullptr) : node(start) {}
+
+    reference operator*() const { return *node; }
+    pointer operator->() const { return node; }
+    NodeIterator& operator++() { node = node->next; return *this; }
+    NodeIterator operator++(int) { NodeIterator old = *this; node = node->next; return old; }
+    bool operator==(const NodeIterator &other) const { return node == other.node; }
+    bool operator!=(const NodeIterator &other) const { return node != other.node; }
+};
+
+#endif
@@ -6,14 +6,21 @@
 #include <stdexcept>
 #include <algorithm>
 #include <cctype>
-#include <windows.h>
-#include <psapi.h>
 #include "utility.h"
-#pragma comment(lib, "psapi.lib")
+#include "duplicate_detector.h"
+#include "metrics.h"
+#include "trace.h"
+#include "memory_accounting.h"
+#include "snapshot_writer.h"
+#include "bulk_import.h"
+#include "record_filter.h"
+#include "skill_ontology.h"
 using namespace std;
 using namespace std::chrono;
 
-ResumeArray::ResumeArray() : resumes(nullptr), resumesCount(0), resumesCapacity(0) {}
+static const int MEMORY_STORE = MemoryAccounting::registerStore("Resume Array");
+
+ResumeArray::ResumeArray() : resumes(nullptr), resumesCount(0), resumesCapacity(0), duplicates(nullptr) {}
 
 ResumeArray::~ResumeArray() {
     delete[] resumes;
@@ -21,19 +28,82 @@ ResumeArray::~ResumeArray() {
 
 void ResumeArray::ensureCapacity(int minCapacity) {
     if (resumesCapacity >= minCapacity) return;
+    TRACE_SCOPE("ensureCapacity (grow)");
     int newCap = (resumesCapacity == 0) ? 100 : resumesCapacity * 2;
     while (newCap < minCapacity) newCap *= 2;
 
     Resume *temp = new Resume[newCap];
     for (int i = 0; i < resumesCount; ++i)
-        temp[i] = resumes[i];
+        temp[i] = std::move(resumes[i]);   // strings keep their buffers
     delete[] resumes;
     resumes = temp;
     resumesCapacity = newCap;
 }
 
+// ---------------- keyword extraction ----------------
+void ResumeArray::extractKeywords(Resume &r) {
+    TRACE_SCOPE("extractKeywords");
+    const string text = r.description.str();   // still plain at insert time
+    string desc = text;
+    transform(desc.begin(), desc.end(), desc.begin(), ::tolower);
+
+    size_t phrasePos = desc.find("skilled in");
+    if (phrasePos == string::npos)
+        phrasePos = desc.find("experienced in");
+    if (phrasePos == string::npos)
+        phrasePos = desc.find("proficient in");
+
+    string skills;
+    if (phrasePos != string::npos) {
+        size_t startPos = phrasePos + (desc.find("in", phrasePos) - phrasePos) + 2;
+        size_t endPos = text.find('.', startPos);
+        if (endPos == string::npos)
+            endPos = text.length();
+        skills = text.substr(startPos, endPos - startPos);
+    }
+
+    stringstream ss(skills);
+    string token;
+    int idx = 0;
+    while (getline(ss, token, ',') && idx < 10) {
+        token.erase(0, token.find_first_not_of(" "));
+        token.erase(token.find_last_not_of(" ") + 1);
+        if (!token.empty())
+            r.keywords[idx++] = token;
+    }
+    for (int i = idx; i < 10; ++i)
+        r.keywords[i] = "";
+    SkillOntology::canonicalize(r.keywords);
+}
+
+void ResumeArray::insertAtEnd(const string &desc) {
+    {
+        MemoryScope scope(MEMORY_STORE, MemoryAccounting::NODES);
+        ensureCapacity(resumesCount + 1);
+    }
+    int id = (resumesCount > 0) ? resumes[resumesCount - 1].resumeID + 1 : 1;  // IDs stay unique after deletes
+    Resume &r = resumes[resumesCount++];
+    r.resumeID = id;
+    {
+        MemoryScope scope(MEMORY_STORE, MemoryAccounting::DESCRIPTIONS);
+        r.description = desc;
+    }
+    {
+        MemoryScope scope(MEMORY_STORE, MemoryAccounting::KEYWORDS);
+        extractKeywords(r);
+    }
+    {
+        MemoryScope scope(MEMORY_STORE, MemoryAccounting::INDEXES);
+        notifyInsert(r);
+    }
+    MemoryScope scope(MEMORY_STORE, MemoryAccounting::DESCRIPTIONS);
+    r.description.pack();   // the indexes have seen the plain text
+}
+
 void ResumeArray::loadFromCSV(const string &filename) {
+    TRACE_SCOPE("loadFromCSV [Resume Array]");
     double memBefore = getCurrentMemoryKB();  // record before loading
+    long long heapBefore = MemoryAccounting::storeBytes(MEMORY_STORE);
     auto start = high_resolution_clock::now();
 
     ifstream file(filename);
@@ -46,50 +116,15 @@ void ResumeArray::loadFromCSV(const string &filename) {
     string line;
     getline(file, line); // skip header
 
-    resumesCount = 0;
-    int id = 1;
+    clear();
 
-    while (getline(file, line)) {
+    while (tracedGetline(file, line)) {
         if (line.empty()) continue;
 
         if (line.front() == '"' && line.back() == '"')
             line = line.substr(1, line.size() - 2);
 
-        ensureCapacity(resumesCount + 1);
-        Resume &r = resumes[resumesCount++];
-        r.resumeID = id++;
-        r.description = line;
-
-        // --- Keyword extraction ---
-        string desc = r.description;
-        transform(desc.begin(), desc.end(), desc.begin(), ::tolower);
-
-        size_t phrasePos = desc.find("skilled in");
-        if (phrasePos == string::npos)
-            phrasePos = desc.find("experienced in");
-        if (phrasePos == string::npos)
-            phrasePos = desc.find("proficient in");
-
-        string skills;
-        if (phrasePos != string::npos) {
-            size_t startPos = phrasePos + (desc.find("in", phrasePos) - phrasePos) + 2;
-            size_t endPos = r.description.find('.', startPos);
-            if (endPos == string::npos)
-                endPos = r.description.length();
-            skills = r.description.substr(startPos, endPos - startPos);
-        }
-
-        stringstream ss(skills);
-        string token;
-        int idx = 0;
-        while (getline(ss, token, ',') && idx < 10) {
-            token.erase(0, token.find_first_not_of(" "));
-            token.erase(token.find_last_not_of(" ") + 1);
-            if (!token.empty())
-                r.keywords[idx++] = token;
-        }
-        for (int i = idx; i < 10; ++i)
-            r.keywords[i] = "";
+        insertAtEnd(line);
     }
 
     file.close();
@@ -101,45 +136,165 @@ void ResumeArray::loadFromCSV(const string &filename) {
 
     cout << "[Performance] loadFromCSV [Resume Array] execution time: "
          << duration << " microseconds\n";
+    recordLatency("load", "Array", duration);
 
     cout << "[Memory] loadFromCSV [Resume Array] memory usage: "
+         << (MemoryAccounting::storeBytes(MEMORY_STORE) - heapBefore) / 1024 << " KB allocated, RSS +"
          << (memAfter - memBefore) << " KB\n\n";
 }
 
 
 
 void ResumeArray::saveToCSV(const string &filename) {
+    TRACE_SCOPE("saveToCSV [Resume Array]");
     auto start = high_resolution_clock::now();
 
-    ofstream file(filename);
-    if (!file.is_open()) {
-        cerr << "Error: cannot open " << filename << " for writing.\n";
-        return;
+    string content = "resume\n";
+    for (int i = 0; i < resumesCount; ++i) {
+        content += '"';
+        resumes[i].description.appendTo(content);
+        content += "\"\n";
     }
-
-    file << "resume" << endl;
-    for (int i = 0; i < resumesCount; ++i)
-        file << '"' << resumes[i].description << '"' << endl;
-
-    file.close();
-    cout << "Successfully saved " << resumesCount << " record(s) to " << filename << endl;
+    long long generation = SnapshotWriter::instance().submit(filename, std::move(content));
+    cout << "Saving " << resumesCount << " record(s) to " << filename << " in the background (generation "
+         << generation << ")\n";
 
     auto end = high_resolution_clock::now();
     cout << "[Performance] Save execution time: "
          << duration_cast<microseconds>(end - start).count()
          << " microseconds\n";
+    recordLatency("save", "Array", duration_cast<microseconds>(end - start).count());
+}
+
+// ===============================
+// Bulk import
+// ===============================
+int ResumeArray::bulkImport(const string &filename) {
+    ifstream file(filename);
+    if (!file.is_open()) {
+        cout << "Error: Cannot open " << filename << endl;
+        return 0;
+    }
+    return bulkImport(file);
+}
+
+int ResumeArray::bulkImport(istream &in) {
+    TRACE_SCOPE("bulkImport [Resume Array]");
+    auto start = high_resolution_clock::now();
+
+    vector<string> lines;
+    {
+        MemoryScope scope(MEMORY_STORE, MemoryAccounting::DESCRIPTIONS);
+        readImportLines(in, "resume", lines);
+    }
+    int added = (int)lines.size();
+    if (added == 0) {
+        cout << "No resumes to import.\n";
+        return 0;
+    }
+
+    {
+        MemoryScope scope(MEMORY_STORE, MemoryAccounting::NODES);
+        ensureCapacity(resumesCount + added);   // one grow for the whole batch
+    }
+    int firstID = (resumesCount > 0) ? resumes[resumesCount - 1].resumeID + 1 : 1;
+    Resume *batch = resumes + resumesCount;
+    for (int i = 0; i < added; ++i) {
+        string &line = lines[i];
+        if (line.size() > 1 && line.front() == '"' && line.back() == '"') {   // same as loadFromCSV
+            line.erase(line.size() - 1);
+            line.erase(0, 1);
+        }
+        batch[i].resumeID = firstID + i;
+        batch[i].description = std::move(line);   // keeps its DESCRIPTIONS tag
+    }
+
+    parallelChunks(added, "import worker", [batch](int begin, int end) {
+        MemoryScope scope(MEMORY_STORE, MemoryAccounting::KEYWORDS);
+        for (int i = begin; i < end; ++i) extractKeywords(batch[i]);
+    });
+    resumesCount += added;
+
+    {
+        MemoryScope scope(MEMORY_STORE, MemoryAccounting::INDEXES);
+        for (int i = 0; i < added; ++i) notifyInsert(batch[i]);
+        for (size_t i = 0; i < listeners.size(); ++i) listeners[i]->onBatchEnd();
+    }
+    parallelChunks(added, "import worker", [batch](int begin, int end) {
+        MemoryScope scope(MEMORY_STORE, MemoryAccounting::DESCRIPTIONS);
+        for (int i = begin; i < end; ++i) batch[i].description.pack();
+    });
+
+    auto end = high_resolution_clock::now();
+    reportBulkImport("Resume Array", "Array", added, duration_cast<microseconds>(end - start).count());
+
+    if (!csvFilename.empty()) saveToCSV(csvFilename);
+    else cout << "Warning: No CSV filename stored.\n";
+    return added;
+}
+
+
+// ===============================
+// Bulk delete
+// ===============================
+int ResumeArray::removeWhere(const RecordPredicate &predicate) {
+    TRACE_SCOPE("removeWhere [Resume Array]");
+    auto start = high_resolution_clock::now();
+
+    // Survivors are moved down over the gaps as the pass goes, so each record
+    // moves at most once instead of the whole tail shifting per delete
+    int kept = 0;
+    for (int i = 0; i < resumesCount; ++i) {
+        Resume &r = resumes[i];
+        if (predicate.matches(r.resumeID, "", r.description, r.keywords)) {
+            notifyRemove(r);
+            continue;
+        }
+        if (kept != i) resumes[kept] = std::move(r);
+        kept++;
+    }
+    int removed = resumesCount - kept;
+    for (int i = kept; i < resumesCount; ++i) resumes[i] = Resume();   // free what removed records left behind
+    resumesCount = kept;
+    if (removed > 0)
+        for (size_t i = 0; i < listeners.size(); ++i) listeners[i]->onBatchEnd();
+
+    auto end = high_resolution_clock::now();
+    reportBulkDelete("Resume Array", "Array", predicate, removed, resumesCount,
+                     duration_cast<microseconds>(end - start).count());
+
+    if (removed > 0) {
+        if (!csvFilename.empty()) saveToCSV(csvFilename);
+        else cout << "Warning: No CSV filename stored.\n";
+    }
+    return removed;
 }
 
 // ===============================
 // Clear
 // ===============================
 void ResumeArray::clear() {
+    detachListeners();
     delete[] resumes;
     resumes = nullptr;
     resumesCount = 0;
     resumesCapacity = 0;
 }
 
+// ===============================
+// Find by ID
+// ===============================
+const Resume* ResumeArray::findResumeByID(int id) const {
+    int lo = 0, hi = resumesCount - 1;
+    while (lo <= hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (resumes[mid].resumeID == id) return &resumes[mid];
+        if (resumes[mid].resumeID < id) lo = mid + 1;
+        else hi = mid - 1;
+    }
+    return nullptr;
+}
+
 // ===============================
 // Display
 // ===============================
@@ -178,28 +333,21 @@ void ResumeArray::display() const {
 // ===============================
 void ResumeArray::addRecord() {
     cout << "\n=== ADD NEW RESUME (Array) ===\n";
-    string desc;
-    cout << "Enter resume description: ";
-    getline(cin, desc);
+    string skills;
+    cout << "Enter your skills (comma-separated, e.g., Python, Java, SQL): ";
+    getline(cin, skills);
 
+    // Same description and extraction as the linked list, so both get the same keywords
     auto start = high_resolution_clock::now();
-    Resume r;
-    r.resumeID = resumesCount + 1;
-    r.description = desc;
-
-    stringstream ss(desc);
-    string word;
-    int k = 0;
-    while (ss >> word && k < 10)
-        r.keywords[k++] = word;
-
-    ensureCapacity(resumesCount + 1);
-    resumes[resumesCount++] = r;
+    insertAtEnd("Experienced professional skilled in " + skills + ".");
 
     auto end = high_resolution_clock::now();
     cout << "[Performance] Add execution time: "
          << duration_cast<microseconds>(end - start).count()
          << " microseconds\n";
+    recordLatency("add", "Array", duration_cast<microseconds>(end - start).count());
+
+    if (duplicates) duplicates->reportDuplicates(resumes[resumesCount - 1].resumeID, "Resume");
 
     if (!csvFilename.empty()) {
         if (confirmAction("Save this change to CSV?"))
@@ -212,21 +360,28 @@ void ResumeArray::addRecord() {
 // ===============================
 // Delete Functions
 // ===============================
+bool ResumeArray::removeAt(int position) {
+    if (position < 1 || position > resumesCount) return false;
+    notifyRemove(resumes[position - 1]);
+    for (int i = position; i < resumesCount; ++i)
+        resumes[i - 1] = std::move(resumes[i]);
+    resumesCount--;
+    return true;
+}
+
 void ResumeArray::deleteFromHead() {
     auto start = high_resolution_clock::now();
 
-    if (resumesCount == 0) {
+    if (!removeAt(1)) {
         cout << "No resumes to delete.\n";
         return;
     }
-    for (int i = 1; i < resumesCount; ++i)
-        resumes[i - 1] = resumes[i];
-    resumesCount--;
 
     auto end = high_resolution_clock::now();
     cout << "[Performance] Delete-from-head execution time: "
          << duration_cast<microseconds>(end - start).count()
          << " microseconds\n";
+    recordLatency("delete", "Array", duration_cast<microseconds>(end - start).count());
 
     if (!csvFilename.empty() && confirmAction("Save this change to CSV?"))
         saveToCSV(csvFilename);
@@ -239,18 +394,16 @@ void ResumeArray::deleteFromMiddle(int position) {
         cout << "No resumes to delete.\n";
         return;
     }
-    if (position < 1 || position > resumesCount) {
+    if (!removeAt(position)) {
         cout << "Invalid position.\n";
         return;
     }
-    for (int i = position; i < resumesCount; ++i)
-        resumes[i - 1] = resumes[i];
-    resumesCount--;
 
     auto end = high_resolution_clock::now();
     cout << "[Performance] Delete-from-middle execution time: "
          << duration_cast<microseconds>(end - start).count()
          << " microseconds\n";
+    recordLatency("delete", "Array", duration_cast<microseconds>(end - start).count());
 
     if (!csvFilename.empty() && confirmAction("Save this change to CSV?"))
         saveToCSV(csvFilename);
@@ -259,16 +412,16 @@ void ResumeArray::deleteFromMiddle(int position) {
 void ResumeArray::deleteFromTail() {
     auto start = high_resolution_clock::now();
 
-    if (resumesCount == 0) {
+    if (!removeAt(resumesCount)) {
         cout << "No resumes to delete.\n";
         return;
     }
-    resumesCount--;
 
     auto end = high_resolution_clock::now();
     cout << "[Performance] Delete-from-tail execution time: "
          << duration_cast<microseconds>(end - start).count()
          << " microseconds\n";
+    recordLatency("delete", "Array", duration_cast<microseconds>(end - start).count());
 
     if (!csvFilename.empty() && confirmAction("Save this change to CSV?"))
         saveToCSV(csvFilename);
@@ -284,3 +437,49 @@ bool ResumeArray::confirmAction(const string &message) {
     cin.ignore();
     return (c == 'y' || c == 'Y');
 }
+
+// ===============================
+// Listeners
+// ===============================
+void ResumeArray::addListener(RecordListener *listener) {
+    listeners.push_back(listener);
+    for (int i = 0; i < resumesCount; ++i)
+        listener->onInsert(resumes[i].resumeID, "", resumes[i].description.str(), resumes[i].keywords);
+}
+
+void ResumeArray::reextractKeywords() {
+    TRACE_SCOPE("reextractKeywords");
+    {
+        MemoryScope scope(MEMORY_STORE, MemoryAccounting::INDEXES);
+        detachListeners();   // shared listeners must see the old keywords go
+    }
+    {
+        MemoryScope scope(MEMORY_STORE, MemoryAccounting::KEYWORDS);
+        for (int i = 0; i < resumesCount; ++i) extractKeywords(resumes[i]);
+    }
+    MemoryScope scope(MEMORY_STORE, MemoryAccounting::INDEXES);
+    for (int i = 0; i < resumesCount; ++i) notifyInsert(resumes[i]);
+    for (size_t i = 0; i < listeners.size(); ++i) listeners[i]->onBatchEnd();
+}
+
+void ResumeArray::detachListeners() {
+    for (size_t l = 0; l < listeners.size(); ++l) {
+        if (!listeners[l]->sharedBetweenStores()) {
+            listeners[l]->onClear();
+            continue;
+        }
+        for (int i = 0; i < resumesCount; ++i)
+            listeners[l]->onRemove(resumes[i].resumeID, "", resumes[i].description.str(), resumes[i].keywords);
+    }
+}
+
+void ResumeArray::notifyInsert(const Resume &r) {
+    TRACE_SCOPE("notifyListeners");
+    for (size_t i = 0; i < listeners.size(); ++i)
+        listeners[i]->onInsert(r.resumeID, "", r.description.str(), r.keywords);
+}
+
+void ResumeArray::notifyRemove(const Resume &r) {
+    for (size_t i = 0; i < listeners.size(); ++i)
+        listeners[i]->onRemove(r.resumeID, "", r.description.str(), r.keywords);
+}
@@ -2,12 +2,20 @@
 #define RESUME_ARRAY_H
 
 #include <string>
+#include <istream>
 #include <stdexcept>
+#include <vector>
+#include "record_listener.h"
+#include "record_store.h"
+#include "text_codec.h"
+
+class DuplicateDetector;
+class RecordPredicate;
 using namespace std;
 
 struct Resume {
     int resumeID;            // auto ID
-    string description;      // full text
+    PackedText description;  // full text (compressed with --compress)
     string keywords[10];     // max 10 extracted keywords
 };
 
@@ -17,17 +25,33 @@ private:
     int resumesCount;        // number of resumes currently stored
     int resumesCapacity;     // allocated capacity
     string csvFilename;      // store filename used to load/save temp CSV
+    vector<RecordListener*> listeners;  // indexes kept in sync with the array
+    DuplicateDetector *duplicates;      // optional, checked by addRecord()
 
     void ensureCapacity(int minCapacity);  // increase capacity when needed
+    void notifyInsert(const Resume &r);
+    void notifyRemove(const Resume &r);
+    void detachListeners();           // listeners forget every record of this store
 
 public:
     ResumeArray();
     ~ResumeArray();
 
+    // Insert new resume at end (extracts keywords, assigns next ID)
+    void insertAtEnd(const string &desc);
+
+    // Fill r.keywords from the "skilled in ..." clause of r.description
+    static void extractKeywords(Resume &r);
+
     // Load and Save (same logic as LL version)
     void loadFromCSV(const string &filename);
     void saveToCSV(const string &filename);
 
+    // Append a whole file/stream of resumes in one batch (bulk_import.h);
+    // returns how many were added
+    int bulkImport(const string &filename);
+    int bulkImport(istream &in);
+
     // Clear array
     void clear();
 
@@ -38,6 +62,18 @@ public:
         return resumes[index];
     }
 
+    // Find resume by ID (IDs are kept ascending, so this is a binary search)
+    const Resume* findResumeByID(int id) const;
+
+    // RecordStore contract (record_store.h)
+    typedef Resume record_type;
+    typedef const Resume* const_iterator;
+    static const bool INDEXED_LOOKUP = true;
+    const_iterator begin() const { return resumes; }
+    const_iterator end() const { return resumes + resumesCount; }
+    const Resume* findByID(int id) const { return findResumeByID(id); }
+    static const char* backendName() { return "Array"; }
+
     // Display preview
     void display() const;
 
@@ -47,8 +83,25 @@ public:
     void deleteFromMiddle(int position); // delete from middle (1-based)
     void deleteFromTail();               // delete last
 
+    // Silent delete (no output, no prompt, no save) for scripted runs;
+    // listeners are notified. Returns false for an invalid position.
+    bool removeAt(int position);         // 1-based
+
+    // Remove every resume the predicate matches in one pass, then save once
+    int removeWhere(const RecordPredicate &predicate);
+
     // Confirmation utility
     bool confirmAction(const string &message);
+
+    // Register an index/cache to be told about every insert and delete
+    void addListener(RecordListener *listener);
+
+    // Re-extract every record's keywords after the skill ontology is
+    // reloaded, then rebuild the listeners from them
+    void reextractKeywords();
+
+    // Near-duplicate warning printed after addRecord() (detector must also be a listener)
+    void setDuplicateDetector(DuplicateDetector *detector) { duplicates = detector; }
 };
 
 #endif
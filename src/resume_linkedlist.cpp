@@ -5,25 +5,37 @@
 #include <algorithm>
 #include <cctype>
 #include <chrono>
-#include <windows.h>
-#include <psapi.h>
 #include "utility.h"
+#include "duplicate_detector.h"
+#include "metrics.h"
+#include "trace.h"
+#include "memory_accounting.h"
+#include "snapshot_writer.h"
+#include "bulk_import.h"
+#include "record_filter.h"
+#include "skill_ontology.h"
 using namespace std;
 using namespace std::chrono;
 
+static const int MEMORY_STORE = MemoryAccounting::registerStore("Resume Linked List");
+
 ResumeLinkedList::ResumeLinkedList() {
     head = tail = nullptr;
     count = 0;
     csvFilename = "";
+    duplicates = nullptr;
 }
 
 ResumeLinkedList::~ResumeLinkedList() {
+    listeners.clear();  // listeners may already be destroyed
     clear();
 }
 
 // ---------------- keyword extraction ----------------
 void extractResumeKeywords(ResumeNode *node) {
-    string desc = node->description;
+    TRACE_SCOPE("extractKeywords");
+    const string text = node->description.str();   // still plain at insert time
+    string desc = text;
     transform(desc.begin(), desc.end(), desc.begin(), ::tolower);
 
     size_t startPos = desc.find("skilled in");
@@ -35,7 +47,7 @@ void extractResumeKeywords(ResumeNode *node) {
     if (endPos == string::npos)
         endPos = desc.length();
 
-    string skills = node->description.substr(startPos, endPos - startPos);
+    string skills = text.substr(startPos, endPos - startPos);
 
     skills.erase(0, skills.find_first_not_of(" "));
     skills.erase(skills.find_last_not_of(" ") + 1);
@@ -52,22 +64,27 @@ void extractResumeKeywords(ResumeNode *node) {
 
     for (int i = idx; i < 10; ++i)
         node->keywords[i] = "";
+    SkillOntology::canonicalize(node->keywords);
 }
 
 
 void printMemoryUsage() {
-    PROCESS_MEMORY_COUNTERS memInfo;
-    GetProcessMemoryInfo(GetCurrentProcess(), &memInfo, sizeof(memInfo));
-    SIZE_T memUsedKB = memInfo.WorkingSetSize / 1024;
-    cout << "[Memory Usage] memory usage: " << memUsedKB << " KB\n\n";
+    cout << "[Memory Usage] memory usage: " << MemoryAccounting::residentKB() << " KB\n\n";
 }
 
 
 // ---------------- insert node ----------------
 void ResumeLinkedList::insertAtEnd(const string &desc) {
-    ResumeNode *node = new ResumeNode();
-    node->resumeID = count + 1;
-    node->description = desc;
+    ResumeNode *node;
+    {
+        MemoryScope scope(MEMORY_STORE, MemoryAccounting::NODES);
+        node = new ResumeNode();
+    }
+    node->resumeID = tail ? tail->resumeID + 1 : 1;  // IDs stay unique after deletes
+    {
+        MemoryScope scope(MEMORY_STORE, MemoryAccounting::DESCRIPTIONS);
+        node->description = desc;
+    }
     node->next = nullptr;
 
     if (!head)
@@ -78,12 +95,23 @@ void ResumeLinkedList::insertAtEnd(const string &desc) {
     }
 
     count++;
-    extractResumeKeywords(node);
+    {
+        MemoryScope scope(MEMORY_STORE, MemoryAccounting::KEYWORDS);
+        extractResumeKeywords(node);
+    }
+    {
+        MemoryScope scope(MEMORY_STORE, MemoryAccounting::INDEXES);
+        notifyInsert(node);
+    }
+    MemoryScope scope(MEMORY_STORE, MemoryAccounting::DESCRIPTIONS);
+    node->description.pack();   // the indexes have seen the plain text
 }
 
 // ---------------- load file ----------------
 void ResumeLinkedList::loadFromCSV(const string &filename) {
+    TRACE_SCOPE("loadFromCSV [Resume Linked List]");
     double memBefore = getCurrentMemoryKB();  // record before loading
+    long long heapBefore = MemoryAccounting::storeBytes(MEMORY_STORE);
     auto start = high_resolution_clock::now();
     
     ifstream file(filename);
@@ -98,7 +126,7 @@ void ResumeLinkedList::loadFromCSV(const string &filename) {
 
     getline(file, line); // Skip header
 
-    while (getline(file, line)) {
+    while (tracedGetline(file, line)) {
         if (line.empty()) continue;
         insertAtEnd(line);
         recordCount++;
@@ -113,41 +141,147 @@ void ResumeLinkedList::loadFromCSV(const string &filename) {
 
     cout << "[Performance] loadFromCSV [Resume Linked List] execution time: "
          << duration << " microseconds\n";
+    recordLatency("load", "Linked List", duration);
 
     cout << "[Memory] loadFromCSV [Resume Linked List] memory usage: "
+         << (MemoryAccounting::storeBytes(MEMORY_STORE) - heapBefore) / 1024 << " KB allocated, RSS +"
          << (memAfter - memBefore) << " KB\n\n";
 }
 
 
 // ---------------- save file ----------------
 void ResumeLinkedList::saveToCSV(const string &filename) {
+    TRACE_SCOPE("saveToCSV [Resume Linked List]");
     auto start = high_resolution_clock::now();
 
-    ofstream file(filename);
-    if (!file.is_open()) {
-        cout << "Error: Cannot open " << filename << " for writing" << endl;
-        return;
-    }
-
-    file << "resume" << endl;
-
+    string content = "resume\n";
     ResumeNode *curr = head;
     while (curr) {
-        file << "\"" << curr->description << "\"" << endl;
+        content += '"';
+        curr->description.appendTo(content);
+        content += "\"\n";
         curr = curr->next;
     }
-
-    file.close();
-    cout << "Successfully saved " << count << " records to " << filename << endl;
+    long long generation = SnapshotWriter::instance().submit(filename, std::move(content));
+    cout << "Saving " << count << " records to " << filename << " in the background (generation "
+         << generation << ")\n";
     
     auto end = high_resolution_clock::now();
     cout << "[Performance] saveToCSV execution time: "
          << duration_cast<microseconds>(end - start).count()
          << " microseconds\n";
+    recordLatency("save", "Linked List", duration_cast<microseconds>(end - start).count());
+}
+
+// ---------------- bulkImport ----------------
+int ResumeLinkedList::bulkImport(const string &filename) {
+    ifstream file(filename);
+    if (!file.is_open()) {
+        cout << "Error: Cannot open " << filename << endl;
+        return 0;
+    }
+    return bulkImport(file);
+}
+
+int ResumeLinkedList::bulkImport(istream &in) {
+    TRACE_SCOPE("bulkImport [Resume Linked List]");
+    auto start = high_resolution_clock::now();
+
+    vector<string> lines;
+    {
+        MemoryScope scope(MEMORY_STORE, MemoryAccounting::DESCRIPTIONS);
+        readImportLines(in, "resume", lines);
+    }
+    int added = (int)lines.size();
+    if (added == 0) {
+        cout << "No resumes to import.\n";
+        return 0;
+    }
+
+    // Nodes are built off to the side and linked in only once they are complete
+    vector<ResumeNode*> batch(added);
+    int firstID = tail ? tail->resumeID + 1 : 1;
+    {
+        MemoryScope scope(MEMORY_STORE, MemoryAccounting::NODES);
+        for (int i = 0; i < added; ++i) {
+            batch[i] = new ResumeNode();
+            batch[i]->resumeID = firstID + i;
+            batch[i]->description = std::move(lines[i]);   // keeps its DESCRIPTIONS tag
+            batch[i]->next = nullptr;
+        }
+    }
+
+    ResumeNode **nodes = batch.data();
+    parallelChunks(added, "import worker", [nodes](int begin, int end) {
+        MemoryScope scope(MEMORY_STORE, MemoryAccounting::KEYWORDS);
+        for (int i = begin; i < end; ++i) extractResumeKeywords(nodes[i]);
+    });
+
+    for (int i = 0; i + 1 < added; ++i) batch[i]->next = batch[i + 1];
+    if (!head) head = batch[0];
+    else tail->next = batch[0];
+    tail = batch[added - 1];
+    count += added;
+
+    {
+        MemoryScope scope(MEMORY_STORE, MemoryAccounting::INDEXES);
+        for (int i = 0; i < added; ++i) notifyInsert(batch[i]);
+        for (size_t i = 0; i < listeners.size(); ++i) listeners[i]->onBatchEnd();
+    }
+    parallelChunks(added, "import worker", [nodes](int begin, int end) {
+        MemoryScope scope(MEMORY_STORE, MemoryAccounting::DESCRIPTIONS);
+        for (int i = begin; i < end; ++i) nodes[i]->description.pack();
+    });
+
+    auto end = high_resolution_clock::now();
+    reportBulkImport("Resume Linked List", "Linked List", added, duration_cast<microseconds>(end - start).count());
+
+    if (!csvFilename.empty()) saveToCSV(csvFilename);
+    else cout << "Warning: No CSV filename stored.\n";
+    return added;
+}
+
+// ---------------- removeWhere ----------------
+int ResumeLinkedList::removeWhere(const RecordPredicate &predicate) {
+    TRACE_SCOPE("removeWhere [Resume Linked List]");
+    auto start = high_resolution_clock::now();
+
+    // One traversal: matching nodes are unlinked behind the last kept node
+    int removed = 0;
+    ResumeNode *prev = nullptr;
+    ResumeNode *curr = head;
+    while (curr) {
+        ResumeNode *next = curr->next;
+        if (predicate.matches(curr->resumeID, "", curr->description, curr->keywords)) {
+            notifyRemove(curr);
+            if (prev) prev->next = next;
+            else head = next;
+            delete curr;
+            removed++;
+        } else {
+            prev = curr;
+        }
+        curr = next;
+    }
+    tail = prev;
+    count -= removed;
+    if (removed > 0)
+        for (size_t i = 0; i < listeners.size(); ++i) listeners[i]->onBatchEnd();
+
+    auto end = high_resolution_clock::now();
+    reportBulkDelete("Resume Linked List", "Linked List", predicate, removed, count,
+                     duration_cast<microseconds>(end - start).count());
+
+    if (removed > 0) {
+        if (!csvFilename.empty()) saveToCSV(csvFilename);
+        else cout << "Warning: No CSV filename stored.\n";
+    }
+    return removed;
 }
 
 // ---------------- utility ----------------
 void ResumeLinkedList::clear() {
+    detachListeners();
     while (head) {
         ResumeNode *temp = head;
         head = head->next;
@@ -223,6 +357,9 @@ void ResumeLinkedList::addRecord() {
     cout << "[Performance] addRecord execution time: "
          << duration_cast<microseconds>(end - start).count()
          << " microseconds\n";
+    recordLatency("add", "Linked List", duration_cast<microseconds>(end - start).count());
+
+    if (duplicates) duplicates->reportDuplicates(tail->resumeID, "Resume");
 
     if (confirmAction("A new resume record has been added to the list.")) {
         if (!csvFilename.empty()) {
@@ -268,6 +405,26 @@ void ResumeLinkedList::addRecord() {
 // }
 
 
+// ---------------- remove at ----------------
+bool ResumeLinkedList::removeAt(int position) {
+    if (position < 1 || position > count) return false;
+
+    ResumeNode *prev = nullptr;
+    ResumeNode *curr = head;
+    for (int i = 1; i < position; i++) {
+        prev = curr;
+        curr = curr->next;
+    }
+
+    notifyRemove(curr);
+    if (prev) prev->next = curr->next;
+    else head = curr->next;
+    if (curr == tail) tail = prev;
+    delete curr;
+    count--;
+    return true;
+}
+
 // ---------------- delete from head ----------------
 void ResumeLinkedList::deleteFromHead() {
     auto start = high_resolution_clock::now();
@@ -283,15 +440,13 @@ void ResumeLinkedList::deleteFromHead() {
     cout << "Description: " << temp->description << endl;
     cout << "=================================\n";
     
-    head = head->next;
-    if (!head) tail = nullptr;
-    delete temp;
-    count--;
+    removeAt(1);
 
     auto end = high_resolution_clock::now();
     cout << "[Performance] deleteFromHead execution time: "
          << duration_cast<microseconds>(end - start).count()
          << " microseconds\n";
+    recordLatency("delete", "Linked List", duration_cast<microseconds>(end - start).count());
     
     if (confirmAction("Resume record has been deleted from the list.")) {
         if (!csvFilename.empty()) saveToCSV(csvFilename);
@@ -321,26 +476,21 @@ void ResumeLinkedList::deleteFromMiddle(int position) {
     }
 
     ResumeNode *curr = head;
-    ResumeNode *prev = nullptr;
-
-    for (int i = 1; i < position; i++) {
-        prev = curr;
+    for (int i = 1; i < position; i++)
         curr = curr->next;
-    }
 
     cout << "\n=== DELETING RESUME FROM POSITION " << position << " ===\n";
     cout << "Resume ID: " << curr->resumeID << endl;
     cout << "Description: " << curr->description << endl;
     cout << "=================================\n";
 
-    prev->next = curr->next;
-    delete curr;
-    count--;
+    removeAt(position);
 
     auto end = high_resolution_clock::now();
     cout << "[Performance] deleteFromMiddle execution time: "
          << duration_cast<microseconds>(end - start).count()
          << " microseconds\n";
+    recordLatency("delete", "Linked List", duration_cast<microseconds>(end - start).count());
 
     if (confirmAction("Resume record has been deleted from the list.")) {
         if (!csvFilename.empty()) saveToCSV(csvFilename);
@@ -364,24 +514,13 @@ void ResumeLinkedList::deleteFromTail() {
     cout << "Description: " << tail->description << endl;
     cout << "=================================\n";
 
-    if (head == tail) {
-        delete head;
-        head = tail = nullptr;
-        count--;
-    } else {
-        ResumeNode *curr = head;
-        while (curr->next != tail)
-            curr = curr->next;
-        delete tail;
-        tail = curr;
-        tail->next = nullptr;
-        count--;
-    }
+    removeAt(count);
 
     auto end = high_resolution_clock::now();
     cout << "[Performance] deleteFromTail execution time: "
          << duration_cast<microseconds>(end - start).count()
          << " microseconds\n";
+    recordLatency("delete", "Linked List", duration_cast<microseconds>(end - start).count());
 
     if (confirmAction("Resume record has been deleted from the list.")) {
         if (!csvFilename.empty()) saveToCSV(csvFilename);
@@ -391,7 +530,7 @@ void ResumeLinkedList::deleteFromTail() {
     }
 }
 
-ResumeNode* ResumeLinkedList::findResumeByID(int id) {
+ResumeNode* ResumeLinkedList::findResumeByID(int id) const {
     ResumeNode* current = head;
     while (current) {
         if (current->resumeID == id)
@@ -400,3 +539,47 @@ ResumeNode* ResumeLinkedList::findResumeByID(int id) {
     }
     return nullptr; // not found
 }
+
+// ---------------- listeners ----------------
+void ResumeLinkedList::addListener(RecordListener *listener) {
+    listeners.push_back(listener);
+    for (ResumeNode *curr = head; curr; curr = curr->next)
+        listener->onInsert(curr->resumeID, "", curr->description.str(), curr->keywords);
+}
+
+void ResumeLinkedList::reextractKeywords() {
+    TRACE_SCOPE("reextractKeywords");
+    {
+        MemoryScope scope(MEMORY_STORE, MemoryAccounting::INDEXES);
+        detachListeners();   // shared listeners must see the old keywords go
+    }
+    {
+        MemoryScope scope(MEMORY_STORE, MemoryAccounting::KEYWORDS);
+        for (ResumeNode *curr = head; curr; curr = curr->next) extractResumeKeywords(curr);
+    }
+    MemoryScope scope(MEMORY_STORE, MemoryAccounting::INDEXES);
+    for (ResumeNode *curr = head; curr; curr = curr->next) notifyInsert(curr);
+    for (size_t i = 0; i < listeners.size(); ++i) listeners[i]->onBatchEnd();
+}
+
+void ResumeLinkedList::detachListeners() {
+    for (size_t l = 0; l < listeners.size(); ++l) {
+        if (!listeners[l]->sharedBetweenStores()) {
+            listeners[l]->onClear();
+            continue;
+        }
+        for (ResumeNode *curr = head; curr; curr = curr->next)
+            listeners[l]->onRemove(curr->resumeID, "", curr->description.str(), curr->keywords);
+    }
+}
+
+void ResumeLinkedList::notifyInsert(const ResumeNode *node) {
+    TRACE_SCOPE("notifyListeners");
+    for (size_t i = 0; i < listeners.size(); ++i)
+        listeners[i]->onInsert(node->resumeID, "", node->description.str(), node->keywords);
+}
+
+void ResumeLinkedList::notifyRemove(const ResumeNode *node) {
+    for (size_t i = 0; i < listeners.size(); ++i)
+        listeners[i]->onRemove(node->resumeID, "", node->description.str(), node->keywords);
+}
@@ -2,21 +2,38 @@
 #define RESUME_LINKEDLIST_H
 
 #include <string>
+#include <istream>
+#include <vector>
+#include "record_listener.h"
+#include "record_store.h"
+#include "text_codec.h"
+
+class DuplicateDetector;
+class RecordPredicate;
 using namespace std;
 
 struct ResumeNode {
     int resumeID;          // auto ID
-    string description;    // full text
+    PackedText description; // full text (compressed with --compress)
     string keywords[10];   // max 10 extracted keywords
     ResumeNode *next;
 };
 
+// Fill keywords from the "skilled in ..." part of the description
+void extractResumeKeywords(ResumeNode *node);
+
 class ResumeLinkedList {
 private:
     ResumeNode *head;
     ResumeNode *tail;
     int count;
     string csvFilename;  // store the CSV filename for saving
+    vector<RecordListener*> listeners;  // indexes kept in sync with the list
+    DuplicateDetector *duplicates;      // optional, checked by addRecord()
+
+    void notifyInsert(const ResumeNode *node);
+    void notifyRemove(const ResumeNode *node);
+    void detachListeners();           // listeners forget every record of this store
 
 public:
     ResumeLinkedList();
@@ -25,6 +42,11 @@ public:
     void insertAtEnd(const string &desc);
     void loadFromCSV(const string &filename);
     void saveToCSV(const string &filename);  // save current list to CSV
+
+    // Append a whole file/stream of resumes in one batch, saving once at the end
+    int bulkImport(const string &filename);
+    int bulkImport(istream &in);
+
     void clear();
     int size() const;
     ResumeNode *getHead() const;
@@ -35,10 +57,36 @@ public:
     void deleteFromHead();                  // delete first record
     void deleteFromMiddle(int position);    // delete from middle (1-based index)
     void deleteFromTail();                  // delete last record
+
+    // Silent delete (no output, no prompt, no save) for scripted runs;
+    // listeners are notified. Returns false for an invalid position.
+    bool removeAt(int position);         // 1-based
+
+    // Unlink every resume the predicate matches in one traversal, then save once
+    int removeWhere(const RecordPredicate &predicate);
     
     // Helper functions
     bool confirmAction(const string &message);  // ask user confirmation
-    ResumeNode* findResumeByID(int id);
+    ResumeNode* findResumeByID(int id) const;
+
+    // RecordStore contract (record_store.h)
+    typedef ResumeNode record_type;
+    typedef NodeIterator<ResumeNode> const_iterator;
+    static const bool INDEXED_LOOKUP = false;
+    const_iterator begin() const { return const_iterator(head); }
+    const_iterator end() const { return const_iterator(); }
+    const ResumeNode* findByID(int id) const { return findResumeByID(id); }
+    static const char* backendName() { return "Linked List"; }
+
+    // Register an index/cache to be told about every insert and delete
+    void addListener(RecordListener *listener);
+
+    // Re-extract every record's keywords after the skill ontology is
+    // reloaded, then rebuild the listeners from them
+    void reextractKeywords();
+
+    // Near-duplicate warning printed after addRecord() (detector must also be a listener)
+    void setDuplicateDetector(DuplicateDetector *detector) { duplicates = detector; }
 };
 
 #endif
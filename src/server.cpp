@@ -0,0 +1,245 @@
+#include "server.h"
+#include "matching.h"
+#include "metrics.h"
+#include "trace.h"
+#include "memory_accounting.h"
+#include "snapshot_writer.h"
+#include "record_filter.h"
+#include "text_codec.h"
+#include "query_arena.h"
+#include "query_planner.h"
+#include "skill_ontology.h"
+#include "analytics.h"
+#include <iostream>
+#include <sstream>
+#include <cstdlib>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+using namespace std;
+using namespace std::chrono;
+
+// ---------------- periodic dump ----------------
+class MetricsDumper {
+private:
+    string filename;
+    int interval;
+    bool stopping;
+    mutex lock;
+    condition_variable wake;
+    thread worker;
+
+    void run() {
+        Tracer::nameThread("metrics dumper");
+        unique_lock<mutex> guard(lock);
+        while (!wake.wait_for(guard, seconds(interval), [this] { return stopping; })) {
+            TRACE_SCOPE("dumpMetrics");
+            MetricsRegistry::instance().dumpToFile(filename);
+        }
+    }
+
+public:
+    MetricsDumper(const string &file, int seconds)
+        : filename(file), interval(seconds > 0 ? seconds : 1), stopping(false),
+          worker(&MetricsDumper::run, this) {}
+
+    ~MetricsDumper() {
+        {
+            lock_guard<mutex> guard(lock);
+            stopping = true;
+        }
+        wake.notify_one();
+        worker.join();
+        MetricsRegistry::instance().dumpToFile(filename);
+    }
+};
+
+// ---------------- commands ----------------
+template <class JobStore, class ResumeStore>
+static void handleCommand(const string &op, istringstream &args, const JobStore &jobs,
+                          ResumeStore &resumes, const SkillIndex &resumeSkills, const string &resumeFile) {
+    const char *backend = ResumeStore::backendName();
+    TRACE_SCOPE("serverCommand");
+    QueryScope query(backend);   // one arena reset per command; the buffer stays warm
+    auto start = high_resolution_clock::now();
+
+    if (op == "match") {
+        int jobID = 0;
+        args >> jobID;
+        const typename JobStore::record_type *job = jobs.findByID(jobID);
+        if (!job) {
+            cout << "ERR job " << jobID << " not found\n";
+            return;
+        }
+        typename MatchResultsFor<ResumeStore>::type matches(resumes.size());
+        QuerySkills skills(job->keywords);
+        for (typename ResumeStore::const_iterator r = resumes.begin(); r != resumes.end(); ++r)
+            matches.append(r->resumeID, Matcher::keywordMatchRate(skills, r->keywords), &r->description);
+        matches.sortDescending();
+        matches.printTop(3, "Resume");
+    } else if (op == "threshold") {
+        int jobID = 0;
+        string rate;   // strtod, not >> double: the stream parse allocates scratch
+        args >> jobID >> rate;
+        char *parsed = nullptr;
+        double minRate = strtod(rate.c_str(), &parsed);
+        if (rate.empty() || *parsed) minRate = -1;
+        const typename JobStore::record_type *job = jobs.findByID(jobID);
+        if (!job) {
+            cout << "ERR job " << jobID << " not found\n";
+            return;
+        }
+        if (minRate < 0 || minRate > 100) {
+            cout << "ERR percent must be 0-100\n";
+            return;
+        }
+        ThresholdQuery::Stats stats;
+        cout << "OK";
+        int found = Matcher::streamThresholdMatches(job->keywords, minRate, resumes, resumeSkills, false, stats);
+        cout << " (" << found << " resumes, " << stats.candidates << " candidates)\n";
+    } else if (op == "search") {
+        string query[10];
+        getline(args >> ws, query[0]);
+        query[0] = SkillOntology::canonical(query[0]);
+        int found = 0;
+        for (typename ResumeStore::const_iterator r = resumes.begin(); r != resumes.end(); ++r)
+            if (Matcher::keywordMatchCount(query, r->keywords) > 0) found++;
+        cout << "OK " << found << " resume(s) list \"" << query[0] << "\"\n";
+        if (!found) MetricsRegistry::instance().increment("search_no_results", backend);
+    } else if (op == "add") {
+        string skills;
+        getline(args >> ws, skills);
+        resumes.insertAtEnd("Experienced professional skilled in " + skills + ".");
+        cout << "OK " << resumes.size() << " resumes\n";
+    } else if (op == "delete") {
+        int position = 0;
+        args >> position;
+        if (!resumes.removeAt(position)) {
+            cout << "ERR invalid position " << position << "\n";
+            return;
+        }
+        cout << "OK " << resumes.size() << " resumes\n";
+    } else if (op == "import") {
+        string file;
+        getline(args >> ws, file);
+        int added = resumes.bulkImport(file);   // saves once and records its own "bulk_import" latency
+        cout << "OK " << added << " imported, " << resumes.size() << " resumes\n";
+        return;
+    } else if (op == "purge") {
+        string kind, argument;
+        args >> kind;
+        getline(args >> ws, argument);
+        RecordPredicate *predicate = makePredicate(kind, argument, nullptr);
+        if (!predicate) return;
+        int removed = resumes.removeWhere(*predicate);   // saves once; records "bulk_delete"
+        delete predicate;
+        cout << "OK " << removed << " removed, " << resumes.size() << " resumes\n";
+        return;
+    } else if (op == "analytics") {
+        string file;
+        getline(args >> ws, file);
+        SkillAnalytics analytics = computeSkillAnalytics(jobs, resumes);   // records "analytics"
+        if (file.empty()) file = "skill_analytics.csv";
+        if (!analytics.writeCSV(file)) {
+            cout << "ERR cannot write " << file << "\n";
+            return;
+        }
+        cout << "OK " << analytics.titles.size() << " titles, " << analytics.overall.size() << " skills -> "
+             << file << " (" << analytics.micros << " microseconds)\n";
+        return;
+    } else if (op == "save") {
+        resumes.saveToCSV(resumeFile);   // queued; records its own "save" latency
+        return;
+    } else {
+        cout << "ERR unknown command " << op << "\n";
+        return;
+    }
+
+    auto end = high_resolution_clock::now();
+    recordLatency(op, backend, duration_cast<microseconds>(end - start).count());
+}
+
+int runServer(JobLinkedList &jobLinkedList, ResumeLinkedList &resumeLinkedList,
+              const SkillIndex &resumeSkillsLinkedList,
+              JobArray &jobArray, ResumeArray &resumeArray, const SkillIndex &resumeSkillsArray,
+              const string &resumeFile, const string &metricsFile, int intervalSeconds) {
+    cout << "========================================\n";
+    cout << "              Server Mode               \n";
+    cout << "========================================\n";
+    cout << "Metrics file: " << metricsFile << " (every " << intervalSeconds << "s)\n";
+
+    MetricsDumper dumper(metricsFile, intervalSeconds);
+
+    string line;
+    while (getline(cin, line)) {
+        istringstream args(line);
+        string op, backend;
+        if (!(args >> op)) continue;
+
+        if (op == "quit") break;
+        bool explain = (op == "explain");
+        if (explain && !(args >> op)) {
+            cout << "ERR explain needs a command\n";
+            continue;
+        }
+        if (op == "saves") {
+            SnapshotWriter::instance().printStatus();
+            continue;
+        }
+        if (op == "memory") {
+            MemoryAccounting::printReport();
+            TextCodec::printReport();
+            QueryArena::printReport();
+            continue;
+        }
+        if (op == "metrics") {
+            cout << (MetricsRegistry::instance().dumpToFile(metricsFile) ? "OK " : "ERR ") << metricsFile << "\n";
+            continue;
+        }
+        if (op == "ontology") {
+            // Both copies of both stores, so the backends keep agreeing
+            string file;
+            if (!(args >> file)) file = SkillOntology::source();
+            if (file.empty() || !SkillOntology::load(file)) {
+                cout << "ERR ontology not loaded\n";
+                continue;
+            }
+            jobLinkedList.reextractKeywords();
+            jobArray.reextractKeywords();
+            resumeLinkedList.reextractKeywords();
+            resumeArray.reextractKeywords();
+            cout << "OK ";
+            SkillOntology::printReport();
+            continue;
+        }
+
+        args >> backend;
+        if (backend == "auto") {
+            // Reads only: a write must name the copy it changes
+            if (op != "match" && op != "search" && op != "threshold" && op != "analytics") {
+                cout << "ERR auto is for match, search, threshold and analytics\n";
+                continue;
+            }
+            const char *metrics[] = { op.c_str(), nullptr };   // each records its own latency under op
+            PlannedQuery plan(op, metrics, explain);
+            if (plan.backend() == 0)
+                handleCommand(op, args, jobLinkedList, resumeLinkedList, resumeSkillsLinkedList, resumeFile);
+            else
+                handleCommand(op, args, jobArray, resumeArray, resumeSkillsArray, resumeFile);
+            continue;
+        }
+        if (explain) {
+            cout << "ERR explain needs backend auto\n";
+            continue;
+        }
+        if (backend == "ll")
+            handleCommand(op, args, jobLinkedList, resumeLinkedList, resumeSkillsLinkedList, resumeFile);
+        else if (backend == "array")
+            handleCommand(op, args, jobArray, resumeArray, resumeSkillsArray, resumeFile);
+        else
+            cout << "ERR backend must be ll, array or auto\n";
+    }
+    SnapshotWriter::instance().flush();
+    return 0;
+}
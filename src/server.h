@@ -0,0 +1,46 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <string>
+#include "job_linkedlist.h"
+#include "resume_linkedlist.h"
+#include "job_array.h"
+#include "resume_array.h"
+#include "skill_index.h"
+using namespace std;
+
+// Non-interactive server mode (run with: main --serve [metrics.prom] [seconds]).
+// Reads one command per line from stdin, runs it against the already loaded
+// stores without prompting, and dumps the latency histograms to the metrics
+// file every few seconds from a background thread (and once more on exit).
+//
+//   match  <ll|array> <jobID>      top 3 resumes for a job
+//   search <ll|array> <keyword>    resumes listing a keyword
+//   threshold <ll|array> <jobID> <percent>
+//                                  every resume matching at least percent of the job's
+//                                  skills exactly (no partial credit), as id:rate
+//   add    <ll|array> <skills...>  append a resume
+//   delete <ll|array> <position>   remove a resume (1-based)
+//   import <ll|array> <file>       append every resume in a file, then save once
+//   purge  <ll|array> skill <name> | ids <1,5,10-20> | text <words>
+//                                  remove every matching resume, then save once
+//   analytics <ll|array> [file]    skill demand per job title vs resume supply as CSV
+//                                  (default skill_analytics.csv)
+//   save   <ll|array>              queue the resumes for a background CSV write
+//   saves                          background save status
+//   metrics                        dump the metrics file now
+//   memory                         per-store heap accounting, RSS and compression
+//   ontology [file]                reload the skill ontology (default: the file loaded
+//                                  last) and re-extract every store's keywords
+//   quit
+//
+// match, search, threshold and analytics also take the backend "auto": the
+// cost-based planner (query_planner.h) runs them on whichever store it
+// currently estimates cheaper. "explain <command> auto ..." does the same and
+// prints the plan before the output and the actual cost after it.
+int runServer(JobLinkedList &jobLinkedList, ResumeLinkedList &resumeLinkedList,
+              const SkillIndex &resumeSkillsLinkedList,
+              JobArray &jobArray, ResumeArray &resumeArray, const SkillIndex &resumeSkillsArray,
+              const string &resumeFile, const string &metricsFile, int intervalSeconds);
+
+#endif
@@ -0,0 +1,326 @@
+#include "sharded_resume_store.h"
+#include "matching.h"
+#include "skill_ontology.h"
+#include <iostream>
+#include <algorithm>
+#include <unordered_map>
+#include <cstdint>
+#ifndef _WIN32
+#include <unistd.h>
+#include <signal.h>
+#include <sys/wait.h>
+#endif
+using namespace std;
+
+// Requests are op, ID, payload length, payload. Replies depend on the op.
+static const char OP_MATCH = 'M';    // id = k, payload = job keywords, '\n'-separated
+static const char OP_ADD = 'A';      // payload = description; reply int ok
+static const char OP_REMOVE = 'R';   // reply int ok
+static const char OP_GET = 'G';      // reply length + description
+static const char OP_SIZE = 'S';     // reply int count
+static const char OP_RELOAD = 'O';   // payload = ontology file ("" = none); reply int ok
+static const char OP_QUIT = 'Q';     // no reply
+
+static bool byRateThenID(const ShardMatch &a, const ShardMatch &b) {
+    return (a.rate != b.rate) ? a.rate > b.rate : a.resumeID < b.resumeID;
+}
+
+ShardedResumeStore::ShardedResumeStore() : nextID(1) {}
+
+ShardedResumeStore::~ShardedResumeStore() {
+    stop();
+}
+
+int ShardedResumeStore::shardFor(int resumeID) const {
+    uint32_t h = (uint32_t)resumeID * 2654435761u;   // Knuth multiplicative hash
+    return (int)((h >> 16) % shards.size());
+}
+
+#ifndef _WIN32
+
+// ---------------- pipe helpers ----------------
+static bool writeAll(int fd, const void *data, size_t size) {
+    const char *p = (const char*)data;
+    while (size > 0) {
+        ssize_t n = write(fd, p, size);
+        if (n <= 0) return false;
+        p += n;
+        size -= (size_t)n;
+    }
+    return true;
+}
+
+static bool readAll(int fd, void *data, size_t size) {
+    char *p = (char*)data;
+    while (size > 0) {
+        ssize_t n = read(fd, p, size);
+        if (n <= 0) return false;
+        p += n;
+        size -= (size_t)n;
+    }
+    return true;
+}
+
+static bool readString(int fd, string &s) {
+    uint32_t len;
+    if (!readAll(fd, &len, sizeof(len))) return false;
+    s.resize(len);
+    return len == 0 || readAll(fd, &s[0], len);
+}
+
+static void writeString(int fd, const string &s) {
+    uint32_t len = (uint32_t)s.size();
+    writeAll(fd, &len, sizeof(len));
+    if (len) writeAll(fd, s.data(), len);
+}
+
+void ShardedResumeStore::send(const Shard &shard, char op, int id, const string &payload) const {
+    writeAll(shard.requestFd, &op, 1);
+    writeAll(shard.requestFd, &id, sizeof(id));
+    writeString(shard.requestFd, payload);
+}
+
+// ---------------- worker process ----------------
+// Holds one shard in memory and answers requests until QUIT or EOF.
+static void runWorker(int requestFd, int responseFd, vector<Resume> &store) {
+    unordered_map<int, int> position;   // resume ID -> index in store
+    for (size_t i = 0; i < store.size(); ++i) position[store[i].resumeID] = (int)i;
+
+    char op;
+    int id;
+    string payload;
+    while (readAll(requestFd, &op, 1) && readAll(requestFd, &id, sizeof(id)) && readString(requestFd, payload)) {
+        if (op == OP_QUIT) break;
+
+        if (op == OP_MATCH) {
+            string jobKeywords[10];
+            size_t start = 0;
+            for (int i = 0; i < 10 && start <= payload.size(); ++i) {
+                size_t end = payload.find('\n', start);
+                if (end == string::npos) end = payload.size();
+                jobKeywords[i] = payload.substr(start, end - start);
+                start = end + 1;
+            }
+
+            vector<ShardMatch> local(store.size());
+            QuerySkills skills(jobKeywords);
+            for (size_t i = 0; i < store.size(); ++i) {
+                local[i].resumeID = store[i].resumeID;
+                local[i].rate = Matcher::keywordMatchRate(skills, store[i].keywords);
+            }
+            int k = min(id, (int)local.size());
+            partial_sort(local.begin(), local.begin() + k, local.end(), byRateThenID);
+
+            writeAll(responseFd, &k, sizeof(k));
+            if (k > 0) writeAll(responseFd, &local[0], k * sizeof(ShardMatch));
+        } else if (op == OP_ADD) {
+            Resume r;
+            r.resumeID = id;
+            r.description = payload;
+            ResumeArray::extractKeywords(r);
+            r.description.pack();
+            int ok = position.count(id) ? 0 : 1;
+            if (ok) {
+                position[id] = (int)store.size();
+                store.push_back(r);
+            }
+            writeAll(responseFd, &ok, sizeof(ok));
+        } else if (op == OP_REMOVE) {
+            unordered_map<int, int>::iterator it = position.find(id);
+            int ok = (it != position.end()) ? 1 : 0;
+            if (ok) {
+                // Order inside a shard does not matter: move the last one into the gap
+                int slot = it->second;
+                position.erase(it);
+                if (slot != (int)store.size() - 1) {
+                    store[slot] = store.back();
+                    position[store[slot].resumeID] = slot;
+                }
+                store.pop_back();
+            }
+            writeAll(responseFd, &ok, sizeof(ok));
+        } else if (op == OP_GET) {
+            unordered_map<int, int>::iterator it = position.find(id);
+            writeString(responseFd, (it != position.end()) ? store[it->second].description.str() : string());
+        } else if (op == OP_SIZE) {
+            int n = (int)store.size();
+            writeAll(responseFd, &n, sizeof(n));
+        } else if (op == OP_RELOAD) {
+            // The worker's rules are its own copy since the fork
+            int ok = 1;
+            if (payload.empty()) SkillOntology::clear();
+            else ok = SkillOntology::load(payload) ? 1 : 0;
+            if (ok)
+                for (size_t i = 0; i < store.size(); ++i) ResumeArray::extractKeywords(store[i]);
+            writeAll(responseFd, &ok, sizeof(ok));
+        }
+    }
+}
+
+// ---------------- coordinator ----------------
+bool ShardedResumeStore::start(int shardCount, const ResumeArray &source) {
+    stop();
+    if (shardCount < 1) return false;
+    signal(SIGPIPE, SIG_IGN);   // a dead worker must not take the coordinator down
+
+    nextID = 1;
+    for (int i = 0; i < source.size(); ++i)
+        nextID = max(nextID, source.getResume(i).resumeID + 1);
+
+    shards.resize(shardCount);
+    for (int s = 0; s < shardCount; ++s) {
+        int toWorker[2], fromWorker[2];
+        if (pipe(toWorker) != 0 || pipe(fromWorker) != 0) {
+            cout << "Failed to create pipes for shard " << s << ".\n";
+            shards.resize(s);
+            stop();
+            return false;
+        }
+
+        cout.flush();
+        pid_t pid = fork();
+        if (pid < 0) {
+            cout << "Failed to fork shard " << s << ".\n";
+            shards.resize(s);
+            stop();
+            return false;
+        }
+
+        if (pid == 0) {
+            // Child: keep only its own pipe ends
+            close(toWorker[1]);
+            close(fromWorker[0]);
+            for (int other = 0; other < s; ++other) {
+                close(shards[other].requestFd);
+                close(shards[other].responseFd);
+            }
+
+            // The forked address space already holds the loaded resumes, so
+            // each worker just copies out its own slice
+            vector<Resume> store;
+            for (int i = 0; i < source.size(); ++i) {
+                const Resume &r = source.getResume(i);
+                if (shardFor(r.resumeID) == s) store.push_back(r);
+            }
+            runWorker(toWorker[0], fromWorker[1], store);
+            _exit(0);
+        }
+
+        close(toWorker[0]);
+        close(fromWorker[1]);
+        shards[s].pid = (int)pid;
+        shards[s].requestFd = toWorker[1];
+        shards[s].responseFd = fromWorker[0];
+    }
+    return true;
+}
+
+void ShardedResumeStore::stop() {
+    for (size_t s = 0; s < shards.size(); ++s) {
+        send(shards[s], OP_QUIT, 0, "");
+        close(shards[s].requestFd);
+        close(shards[s].responseFd);
+        waitpid((pid_t)shards[s].pid, nullptr, 0);
+    }
+    shards.clear();
+}
+
+vector<ShardMatch> ShardedResumeStore::matchTopK(const string jobKeywords[10], int k) const {
+    vector<ShardMatch> merged;
+    if (shards.empty() || k <= 0) return merged;
+
+    string payload;
+    for (int i = 0; i < 10; ++i) payload += jobKeywords[i] + (i < 9 ? "\n" : "");
+
+    // Scatter first so every shard scores in parallel, then gather
+    for (size_t s = 0; s < shards.size(); ++s)
+        send(shards[s], OP_MATCH, k, payload);
+
+    for (size_t s = 0; s < shards.size(); ++s) {
+        int n = 0;
+        if (!readAll(shards[s].responseFd, &n, sizeof(n))) continue;
+        size_t old = merged.size();
+        merged.resize(old + n);
+        if (n > 0) readAll(shards[s].responseFd, &merged[old], n * sizeof(ShardMatch));
+    }
+
+    // The global top-k is always inside the union of the local top-k lists
+    int keep = min(k, (int)merged.size());
+    partial_sort(merged.begin(), merged.begin() + keep, merged.end(), byRateThenID);
+    merged.resize(keep);
+    return merged;
+}
+
+int ShardedResumeStore::add(const string &description) {
+    if (shards.empty()) return -1;
+    int id = nextID++;
+    const Shard &owner = shards[shardFor(id)];
+    send(owner, OP_ADD, id, description);
+    int ok = 0;
+    readAll(owner.responseFd, &ok, sizeof(ok));
+    return ok ? id : -1;
+}
+
+bool ShardedResumeStore::remove(int resumeID) {
+    if (shards.empty()) return false;
+    const Shard &owner = shards[shardFor(resumeID)];
+    send(owner, OP_REMOVE, resumeID, "");
+    int ok = 0;
+    readAll(owner.responseFd, &ok, sizeof(ok));
+    return ok != 0;
+}
+
+string ShardedResumeStore::getDescription(int resumeID) const {
+    string description;
+    if (shards.empty()) return description;
+    const Shard &owner = shards[shardFor(resumeID)];
+    send(owner, OP_GET, resumeID, "");
+    readString(owner.responseFd, description);
+    return description;
+}
+
+bool ShardedResumeStore::reloadOntology() {
+    if (shards.empty()) return false;
+    for (size_t s = 0; s < shards.size(); ++s)
+        send(shards[s], OP_RELOAD, 0, SkillOntology::source());
+
+    bool all = true;
+    for (size_t s = 0; s < shards.size(); ++s) {
+        int ok = 0;
+        readAll(shards[s].responseFd, &ok, sizeof(ok));
+        all = all && ok;
+    }
+    return all;
+}
+
+vector<int> ShardedResumeStore::shardSizes() const {
+    vector<int> sizes;
+    for (size_t s = 0; s < shards.size(); ++s) {
+        send(shards[s], OP_SIZE, 0, "");
+        int n = 0;
+        readAll(shards[s].responseFd, &n, sizeof(n));
+        sizes.push_back(n);
+    }
+    return sizes;
+}
+
+#else
+
+// No fork() on Windows: sharded mode is unavailable, everything is a no-op
+void ShardedResumeStore::send(const Shard &, char, int, const string &) const {}
+
+bool ShardedResumeStore::start(int, const ResumeArray &) {
+    cout << "Sharded mode needs POSIX processes (fork/pipe) and is not available on this platform.\n";
+    return false;
+}
+
+void ShardedResumeStore::stop() { shards.clear(); }
+
+vector<ShardMatch> ShardedResumeStore::matchTopK(const string [10], int) const { return vector<ShardMatch>(); }
+int ShardedResumeStore::add(const string &) { return -1; }
+bool ShardedResumeStore::remove(int) { return false; }
+string ShardedResumeStore::getDescription(int) const { return ""; }
+bool ShardedResumeStore::reloadOntology() { return false; }
+vector<int> ShardedResumeStore::shardSizes() const { return vector<int>(); }
+
+#endif
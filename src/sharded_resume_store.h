@@ -0,0 +1,63 @@
+#ifndef SHARDED_RESUME_STORE_H
+#define SHARDED_RESUME_STORE_H
+
+#include <string>
+#include <vector>
+#include "resume_array.h"
+using namespace std;
+
+struct ShardMatch {
+    int resumeID;
+    double rate;
+};
+
+// Scatter-gather resume store. Resumes are partitioned across N local
+// worker processes by a hash of the resume ID; every worker keeps its own
+// slice in memory and scores it with Matcher::keywordMatchRate.
+// The coordinator (this object) talks to the workers over pipes:
+//   match  - broadcast the job keywords, each shard returns its local top-K,
+//            the coordinator merges them into the global top-K
+//   add    - the new ID is assigned here and routed to the owning shard
+//   remove - routed to the owning shard only
+//   reload - broadcast after a skill ontology reload; each worker reads the
+//            rules file again and re-extracts the keywords of its slice
+// Workers are forked, so sharded mode needs a POSIX system; on other
+// platforms start() reports that and returns false.
+class ShardedResumeStore {
+private:
+    struct Shard {
+        int pid;
+        int requestFd;        // coordinator -> worker
+        int responseFd;       // worker -> coordinator
+    };
+
+    vector<Shard> shards;
+    int nextID;
+
+    int shardFor(int resumeID) const;
+    void send(const Shard &shard, char op, int id, const string &payload) const;
+
+public:
+    ShardedResumeStore();
+    ~ShardedResumeStore();
+
+    // Fork shardCount workers and distribute every resume in source
+    bool start(int shardCount, const ResumeArray &source);
+    void stop();
+    bool isRunning() const { return !shards.empty(); }
+    int shardCount() const { return (int)shards.size(); }
+
+    // Global top-k resumes for the given job keywords (rate desc, then ID asc)
+    vector<ShardMatch> matchTopK(const string jobKeywords[10], int k) const;
+
+    int add(const string &description);      // returns the new resume ID
+    bool remove(int resumeID);
+    string getDescription(int resumeID) const;  // empty if not found
+
+    // Make the workers follow the coordinator's current skill ontology
+    // (SkillOntology::source()); false if any worker rejected the file
+    bool reloadOntology();
+    vector<int> shardSizes() const;
+};
+
+#endif
@@ -0,0 +1,91 @@
+#include "skill_index.h"
+#include "utility.h"
+#include "skill_ontology.h"
+#include <iostream>
+#include <algorithm>
+#include <cctype>
+using namespace std;
+
+SkillIndex::SkillIndex() {}
+
+int SkillIndex::intern(const string &skill) {
+    string key = lowercase(skill);
+    unordered_map<string, int>::iterator it = skillIDs.find(key);
+    if (it != skillIDs.end()) return it->second;
+
+    int id = (int)skillNames.size();
+    skillIDs[key] = id;
+    skillNames.push_back(skill);
+    postings.push_back(CompressedPostings());
+    return id;
+}
+
+int SkillIndex::lookup(const string &skill) const {
+    // Query terms may be aliases; stored keywords are already canonical
+    unordered_map<string, int>::const_iterator it = skillIDs.find(lowercase(SkillOntology::canonical(skill)));
+    return (it == skillIDs.end()) ? -1 : it->second;
+}
+
+const CompressedPostings& SkillIndex::getPostings(int skillID) const {
+    static const CompressedPostings empty;
+    if (skillID < 0 || skillID >= (int)postings.size()) return empty;
+    return postings[skillID];
+}
+
+// ---------------- listener hooks ----------------
+void SkillIndex::onInsert(int id, const string &, const string &, const string keywords[10]) {
+    allRecords.add(id);
+    for (int i = 0; i < 10; ++i) {
+        if (keywords[i].empty() || isStopWord(lowercase(keywords[i]))) continue;  // "Mr", "our", ...
+        postings[intern(keywords[i])].add(id);   // repeated skill -> one entry
+    }
+}
+
+void SkillIndex::onRemove(int id, const string &, const string &, const string keywords[10]) {
+    allRecords.remove(id);
+    for (int i = 0; i < 10; ++i) {
+        if (keywords[i].empty()) continue;
+        // Resolved exactly as onInsert interned it; lookup() is for query terms
+        unordered_map<string, int>::const_iterator it = skillIDs.find(lowercase(keywords[i]));
+        if (it != skillIDs.end()) postings[it->second].remove(id);
+    }
+}
+
+void SkillIndex::onClear() {
+    // Keep the vocabulary (IDs stay stable), drop every posting
+    for (size_t i = 0; i < postings.size(); ++i) postings[i].clear();
+    allRecords.clear();
+}
+
+// ---------------- memory ----------------
+void SkillIndex::optimize() {
+    for (size_t i = 0; i < postings.size(); ++i) postings[i].optimize();
+    allRecords.optimize();
+}
+
+size_t SkillIndex::memoryBytes() const {
+    size_t bytes = sizeof(*this) + allRecords.memoryBytes();
+    for (size_t i = 0; i < postings.size(); ++i) bytes += postings[i].memoryBytes();
+    return bytes;
+}
+
+void SkillIndex::printMemoryReport(const string &label) const {
+    size_t ids = 0, compressed = 0;
+    int counts[3] = { 0, 0, 0 };
+    for (size_t i = 0; i < postings.size(); ++i) {
+        ids += postings[i].cardinality();
+        compressed += postings[i].memoryBytes();
+        postings[i].containerCounts(counts);
+    }
+    size_t plain = ids * sizeof(int) + postings.size() * sizeof(PostingList);
+
+    cout << "[Memory] skill index [" << label << "]: " << postings.size() << " skills, "
+         << ids << " postings\n";
+    cout << "  compressed: " << compressed << " bytes ("
+         << counts[CompressedPostings::ARRAY] << " array / "
+         << counts[CompressedPostings::BITMAP] << " bitmap / "
+         << counts[CompressedPostings::RUN] << " run containers)\n";
+    cout << "  plain int lists would take: " << plain << " bytes";
+    if (compressed > 0) cout << " (" << (double)plain / compressed << "x)";
+    cout << "\n  all-records set: " << allRecords.memoryBytes() << " bytes\n";
+}
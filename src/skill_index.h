@@ -0,0 +1,48 @@
+#ifndef SKILL_INDEX_H
+#define SKILL_INDEX_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "record_listener.h"
+#include "compressed_postings.h"
+using namespace std;
+
+// Inverted index from skill (case-insensitive) to the sorted IDs of every
+// record listing it. Attach it to a resume or job container with
+// addListener() and it stays in sync with inserts and deletes.
+// Stop words that slip into keyword slots ("Mr", "our") are not indexed.
+class SkillIndex : public RecordListener {
+private:
+    unordered_map<string, int> skillIDs;   // lowercase skill -> skill ID
+    vector<string> skillNames;             // display form (first spelling seen)
+    vector<CompressedPostings> postings;   // skill ID -> record IDs
+    CompressedPostings allRecords;         // every indexed record ID
+
+    int intern(const string &skill);
+
+public:
+    SkillIndex();
+
+    void onInsert(int id, const string &title, const string &description, const string keywords[10]);
+    void onRemove(int id, const string &title, const string &description, const string keywords[10]);
+    void onClear();
+    void onBatchEnd() { optimize(); }
+
+    int lookup(const string &skill) const;              // -1 if never seen
+    const CompressedPostings& getPostings(int skillID) const;
+    const CompressedPostings& getAllRecords() const { return allRecords; }
+    const string& getSkillName(int skillID) const { return skillNames[skillID]; }
+    int documentFrequency(int skillID) const { return (int)postings[skillID].cardinality(); }
+    int vocabularySize() const { return (int)skillNames.size(); }
+    int recordCount() const { return (int)allRecords.cardinality(); }
+
+    // Re-pick container types after a bulk load (long ID ranges become runs)
+    void optimize();
+
+    // Compressed footprint vs. a plain int-per-ID list, with container mix
+    size_t memoryBytes() const;
+    void printMemoryReport(const string &label) const;
+};
+
+#endif
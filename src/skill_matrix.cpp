@@ -0,0 +1,264 @@
+#include "skill_matrix.h"
+#include "trace.h"
+#include "utility.h"
+#include "query_arena.h"
+#include <fstream>
+#include <algorithm>
+#include <cctype>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define SKILL_MATRIX_X86 1
+#endif
+using namespace std;
+
+static const int VECTOR_RESUMES = 8;   // widest kernel step; stride and tiles are multiples of it
+
+static inline int popcount64(uint64_t x) {
+#ifdef _MSC_VER
+    return (int)__popcnt64(x);
+#else
+    return __builtin_popcountll(x);
+#endif
+}
+
+// ---------------- encoding ----------------
+SkillMatrix::SkillMatrix() : words(0), stride(0) {}
+
+int SkillMatrix::bitFor(const string &skill) {
+    unordered_map<string, int>::iterator it = skillBits.find(skill);
+    if (it != skillBits.end()) return it->second;
+    int bit = (int)skillBits.size();
+    skillBits[skill] = bit;
+    return bit;
+}
+
+void SkillMatrix::addJob(int id, const string keywords[10]) {
+    int job = (int)jobIDs.size();
+    int first = (int)pendingJobBits.size();
+    int count = 0;
+    pendingJobStart.push_back(first);
+    for (int i = 0; i < 10; ++i) {
+        if (keywords[i].empty()) continue;
+        count++;
+        int bit = bitFor(lowercase(keywords[i]));
+        if (find(pendingJobBits.begin() + first, pendingJobBits.end(), bit) == pendingJobBits.end()) {
+            pendingJobBits.push_back(bit);
+            continue;
+        }
+        // Listed again: keywordMatchCount scores it once per listing
+        size_t r = repeats.size();
+        while (r > 0 && repeats[r - 1].job == job && repeats[r - 1].bit != bit) --r;
+        if (r > 0 && repeats[r - 1].job == job) repeats[r - 1].extra++;
+        else { Repeat repeat = { job, bit, 1 }; repeats.push_back(repeat); }
+    }
+    jobIDs.push_back(id);
+    jobKeywordCounts.push_back((uint8_t)count);
+}
+
+void SkillMatrix::addResume(int id, const string keywords[10]) {
+    pendingResumeStart.push_back((int)pendingResumeBits.size());
+    for (int i = 0; i < 10; ++i) {
+        if (keywords[i].empty()) continue;
+        unordered_map<string, int>::const_iterator it = skillBits.find(lowercase(keywords[i]));
+        if (it != skillBits.end()) pendingResumeBits.push_back(it->second);
+    }
+    resumeIDs.push_back(id);
+}
+
+void SkillMatrix::finalize() {
+    TRACE_SCOPE("encodeBitsets");
+    words = max(1, ((int)skillBits.size() + 63) / 64);
+    stride = (resumeIDs.size() + VECTOR_RESUMES - 1) / VECTOR_RESUMES * VECTOR_RESUMES;
+    pendingJobStart.push_back((int)pendingJobBits.size());
+    pendingResumeStart.push_back((int)pendingResumeBits.size());
+
+    jobBits.assign(jobIDs.size() * words, 0);
+    for (size_t j = 0; j < jobIDs.size(); ++j)
+        for (int b = pendingJobStart[j]; b < pendingJobStart[j + 1]; ++b)
+            jobBits[j * words + pendingJobBits[b] / 64] |= 1ULL << (pendingJobBits[b] % 64);
+
+    resumeBits.assign(stride * words, 0);   // padding resumes stay empty and score 0
+    for (size_t r = 0; r < resumeIDs.size(); ++r)
+        for (int b = pendingResumeStart[r]; b < pendingResumeStart[r + 1]; ++b)
+            resumeBits[(pendingResumeBits[b] / 64) * stride + r] |= 1ULL << (pendingResumeBits[b] % 64);
+
+    vector<int>().swap(pendingJobBits);
+    vector<int>().swap(pendingJobStart);
+    vector<int>().swap(pendingResumeBits);
+    vector<int>().swap(pendingResumeStart);
+}
+
+size_t SkillMatrix::memoryBytes() const {
+    return (jobBits.capacity() + resumeBits.capacity()) * sizeof(uint64_t)
+         + (jobIDs.capacity() + resumeIDs.capacity()) * sizeof(int) + jobKeywordCounts.capacity();
+}
+
+// ---------------- kernels ----------------
+// Score jobCount jobs against count resumes (a multiple of VECTOR_RESUMES).
+// resumes points at the tile's first resume in word 0; word w is stride further.
+typedef void (*TileKernel)(const uint64_t *jobs, int jobCount, int words, const uint64_t *resumes,
+                           size_t stride, int count, uint8_t *out, size_t outStride);
+
+static void scoreTileScalar(const uint64_t *jobs, int jobCount, int words, const uint64_t *resumes,
+                            size_t stride, int count, uint8_t *out, size_t outStride) {
+    for (int j = 0; j < jobCount; ++j) {
+        const uint64_t *job = jobs + (size_t)j * words;
+        uint8_t *row = out + (size_t)j * outStride;
+        for (int r = 0; r < count; ++r) {
+            int score = 0;
+            for (int w = 0; w < words; ++w) score += popcount64(job[w] & resumes[w * stride + r]);
+            row[r] = (uint8_t)score;
+        }
+    }
+}
+
+#ifdef SKILL_MATRIX_X86
+// AVX2 has no 64-bit popcount: count nibbles with a shuffle table, add the
+// bytes across words, and sum each 8-byte lane once at the end (vpsadbw)
+__attribute__((target("avx2")))
+static void scoreTileAVX2(const uint64_t *jobs, int jobCount, int words, const uint64_t *resumes,
+                          size_t stride, int count, uint8_t *out, size_t outStride) {
+    const __m256i table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                           0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i nibble = _mm256_set1_epi8(0x0f);
+    const __m256i zero = _mm256_setzero_si256();
+    for (int j = 0; j < jobCount; ++j) {
+        const uint64_t *job = jobs + (size_t)j * words;
+        uint8_t *row = out + (size_t)j * outStride;
+        for (int r = 0; r < count; r += 4) {
+            __m256i total = zero;
+            for (int w0 = 0; w0 < words; w0 += 31) {   // a byte holds at most 31 x 8
+                __m256i bytes = zero;
+                for (int w = w0; w < words && w < w0 + 31; ++w) {
+                    __m256i v = _mm256_and_si256(_mm256_set1_epi64x((long long)job[w]),
+                                                 _mm256_loadu_si256((const __m256i*)(resumes + w * stride + r)));
+                    __m256i lo = _mm256_shuffle_epi8(table, _mm256_and_si256(v, nibble));
+                    __m256i hi = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+                    bytes = _mm256_add_epi8(bytes, _mm256_add_epi8(lo, hi));
+                }
+                total = _mm256_add_epi64(total, _mm256_sad_epu8(bytes, zero));
+            }
+            // Lane sums sit in the low byte of each 64-bit lane
+            row[r]     = (uint8_t)_mm256_extract_epi8(total, 0);
+            row[r + 1] = (uint8_t)_mm256_extract_epi8(total, 8);
+            row[r + 2] = (uint8_t)_mm256_extract_epi8(total, 16);
+            row[r + 3] = (uint8_t)_mm256_extract_epi8(total, 24);
+        }
+    }
+}
+
+__attribute__((target("avx512f,avx512vpopcntdq")))
+static void scoreTileAVX512(const uint64_t *jobs, int jobCount, int words, const uint64_t *resumes,
+                            size_t stride, int count, uint8_t *out, size_t outStride) {
+    for (int j = 0; j < jobCount; ++j) {
+        const uint64_t *job = jobs + (size_t)j * words;
+        uint8_t *row = out + (size_t)j * outStride;
+        for (int r = 0; r < count; r += 8) {
+            __m512i total = _mm512_setzero_si512();
+            for (int w = 0; w < words; ++w) {
+                __m512i v = _mm512_and_si512(_mm512_set1_epi64((long long)job[w]),
+                                             _mm512_loadu_si512((const void*)(resumes + w * stride + r)));
+                total = _mm512_add_epi64(total, _mm512_popcnt_epi64(v));
+            }
+            _mm512_mask_cvtepi64_storeu_epi8(row + r, 0xff, total);   // 8 scores, one byte each
+        }
+    }
+}
+#endif
+
+static TileKernel kernelFor(SkillMatrix::Kernel kernel) {
+#ifdef SKILL_MATRIX_X86
+    if (kernel == SkillMatrix::AVX512) return scoreTileAVX512;
+    if (kernel == SkillMatrix::AVX2) return scoreTileAVX2;
+#endif
+    (void)kernel;
+    return scoreTileScalar;
+}
+
+bool SkillMatrix::supported(Kernel kernel) {
+    if (kernel == SCALAR) return true;
+#ifdef SKILL_MATRIX_X86
+    __builtin_cpu_init();
+    if (kernel == AVX2) return __builtin_cpu_supports("avx2");
+    if (kernel == AVX512) return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vpopcntdq");
+#endif
+    return false;
+}
+
+SkillMatrix::Kernel SkillMatrix::bestKernel() {
+    static const Kernel best = supported(AVX512) ? AVX512 : supported(AVX2) ? AVX2 : SCALAR;
+    return best;
+}
+
+const char* SkillMatrix::kernelName(Kernel kernel) {
+    static const char *names[KERNEL_COUNT] = { "scalar", "AVX2", "AVX-512" };
+    return names[kernel];
+}
+
+// ---------------- tiled driver ----------------
+void SkillMatrix::scoreAll(ScoreTileSink &sink, Kernel kernel) const {
+    TRACE_SCOPE("scoreAll");
+    if (!supported(kernel)) kernel = SCALAR;
+    TileKernel score = kernelFor(kernel);
+    vector<uint8_t, ArenaAllocator<uint8_t> > tile((size_t)TILE_JOBS * TILE_RESUMES);   // scratch
+
+    for (size_t rb = 0; rb < resumeIDs.size(); rb += TILE_RESUMES) {
+        int count = (int)min((size_t)TILE_RESUMES, stride - rb);   // padded: whole vectors
+        int real = (int)min((size_t)TILE_RESUMES, resumeIDs.size() - rb);
+        size_t repeat = 0;
+        for (size_t jb = 0; jb < jobIDs.size(); jb += TILE_JOBS) {
+            int jobs = (int)min((size_t)TILE_JOBS, jobIDs.size() - jb);
+            score(&jobBits[jb * words], jobs, words, &resumeBits[rb], stride, count, &tile[0], TILE_RESUMES);
+
+            for (; repeat < repeats.size() && repeats[repeat].job < (int)(jb + jobs); ++repeat) {
+                const Repeat &extra = repeats[repeat];
+                const uint64_t *bits = &resumeBits[(extra.bit / 64) * stride + rb];
+                uint64_t mask = 1ULL << (extra.bit % 64);
+                uint8_t *row = &tile[(extra.job - jb) * TILE_RESUMES];
+                for (int r = 0; r < real; ++r)
+                    if (bits[r] & mask) row[r] = (uint8_t)(row[r] + extra.extra);
+            }
+            sink.consume((int)jb, (int)jb + jobs, (int)rb, (int)rb + real, &tile[0], TILE_RESUMES);
+        }
+    }
+}
+
+// ---------------- BatchTop3 ----------------
+BatchTop3::BatchTop3(int jobCount) {
+    Entry empty = { -1, -1 };
+    best.assign((size_t)jobCount * 3, empty);
+}
+
+void BatchTop3::consume(int jobBegin, int jobEnd, int resumeBegin, int resumeEnd,
+                        const uint8_t *scores, size_t stride) {
+    for (int j = jobBegin; j < jobEnd; ++j) {
+        Entry *top = &best[(size_t)j * 3];
+        const uint8_t *row = scores + (size_t)(j - jobBegin) * stride;
+        for (int r = resumeBegin; r < resumeEnd; ++r) {
+            int score = row[r - resumeBegin];
+            if (score <= top[2].score) continue;   // resumes arrive in ID order: ties keep the earlier one
+            int slot = 2;
+            while (slot > 0 && score > top[slot - 1].score) { top[slot] = top[slot - 1]; --slot; }
+            top[slot].resume = r;
+            top[slot].score = score;
+        }
+    }
+}
+
+bool BatchTop3::writeCSV(const string &filename, const SkillMatrix &matrix) const {
+    ofstream out(filename.c_str());
+    if (!out) return false;
+    out << "job_id,rank,resume_id,exact_match_rate\n";
+    for (int j = 0; j < matrix.jobCount(); ++j) {
+        int keywords = matrix.jobKeywordCount(j);
+        if (keywords == 0) continue;
+        const Entry *entries = top(j);
+        for (int k = 0; k < 3 && entries[k].resume >= 0; ++k)
+            out << matrix.jobID(j) << "," << k + 1 << "," << matrix.resumeID(entries[k].resume) << ","
+                << entries[k].score * 100.0 / keywords << "\n";
+    }
+    return (bool)out;
+}
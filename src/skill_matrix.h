@@ -0,0 +1,122 @@
+#ifndef SKILL_MATRIX_H
+#define SKILL_MATRIX_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+using namespace std;
+
+// Receives the score matrix of SkillMatrix::scoreAll() one tile at a time:
+// scores[j * stride + r] is the number of keywords of job jobBegin + j found
+// in resume resumeBegin + r (the same count as Matcher::keywordMatchCount).
+class ScoreTileSink {
+public:
+    virtual ~ScoreTileSink() {}
+    virtual void consume(int jobBegin, int jobEnd, int resumeBegin, int resumeEnd,
+                         const uint8_t *scores, size_t stride) = 0;
+};
+
+// Batched job x resume scoring on skill bitsets.
+//
+// Every distinct job skill (lowercase) gets one bit; a job and a resume
+// become fixed-width bitsets over that vocabulary and a score is
+// popcount(job & resume), so scoring a pair is a few AND + POPCNT
+// instructions instead of 10 x 10 string compares. Resume skills no job
+// asks for get no bit: they can never score.
+//
+// Resumes are stored word-major (word w of every resume, then word w + 1)
+// so a kernel scores one job against 4 (AVX2) or 8 (AVX-512) resumes per
+// instruction. scoreAll() walks resume tiles in the outer loop and job
+// tiles in the inner one: a resume tile is loaded into cache once and
+// scored against every job before the next tile is touched.
+//
+// The kernel is picked at run time from what the CPU supports; the scalar
+// one runs everywhere.
+class SkillMatrix {
+public:
+    enum Kernel { SCALAR, AVX2, AVX512, KERNEL_COUNT };
+
+    static const int TILE_JOBS = 64;
+    static const int TILE_RESUMES = 2048;   // 16 KB per bitset word
+
+private:
+    unordered_map<string, int> skillBits;   // lowercase skill -> bit
+
+    // Bits of each record until finalize() knows the bitset width:
+    // record i owns pendingBits[start[i] .. start[i + 1])
+    vector<int> pendingJobBits, pendingJobStart;
+    vector<int> pendingResumeBits, pendingResumeStart;
+
+    int words;                              // 64-bit words per bitset
+    vector<uint64_t> jobBits;               // job-major: job j, word w at j * words + w
+    vector<uint64_t> resumeBits;            // word-major: word w, resume r at w * stride + r
+    size_t stride;                          // resume count rounded up to a whole vector
+    vector<int> jobIDs, resumeIDs;
+    vector<uint8_t> jobKeywordCounts;       // the rate's denominator
+
+    // A job listing a skill twice scores it twice; the bitset holds it once,
+    // so the extra weight is added back after the kernel (rare)
+    struct Repeat { int job; int bit; int extra; };
+    vector<Repeat> repeats;
+
+    int bitFor(const string &skill);
+
+public:
+    SkillMatrix();
+
+    // Encode two stores (any RecordStore backend). Jobs must all be added
+    // before the first resume: they define the vocabulary.
+    template <class JobStore, class ResumeStore>
+    void build(const JobStore &jobs, const ResumeStore &resumes);
+
+    void addJob(int id, const string keywords[10]);
+    void addResume(int id, const string keywords[10]);
+    void finalize();                        // lay out the bitsets, call once after adding
+
+    int jobCount() const { return (int)jobIDs.size(); }
+    int resumeCount() const { return (int)resumeIDs.size(); }
+    int vocabularySize() const { return (int)skillBits.size(); }
+    int wordsPerBitset() const { return words; }
+    int jobID(int j) const { return jobIDs[j]; }
+    int resumeID(int r) const { return resumeIDs[r]; }
+    int jobKeywordCount(int j) const { return jobKeywordCounts[j]; }
+    size_t memoryBytes() const;
+
+    // Score every job against every resume, handing each tile to sink
+    void scoreAll(ScoreTileSink &sink, Kernel kernel) const;
+    void scoreAll(ScoreTileSink &sink) const { scoreAll(sink, bestKernel()); }
+
+    static bool supported(Kernel kernel);
+    static Kernel bestKernel();
+    static const char* kernelName(Kernel kernel);
+};
+
+// Keeps the best 3 resumes of every job (ties: lower resume ID first, as in
+// matchTop3ForJob) while the tiles stream by
+class BatchTop3 : public ScoreTileSink {
+public:
+    struct Entry { int resume; int score; };   // resume is a SkillMatrix index, -1 if empty
+
+private:
+    vector<Entry> best;                        // 3 per job
+
+public:
+    explicit BatchTop3(int jobCount);
+    void consume(int jobBegin, int jobEnd, int resumeBegin, int resumeEnd,
+                 const uint8_t *scores, size_t stride);
+    const Entry* top(int job) const { return &best[(size_t)job * 3]; }
+
+    // job_id,rank,resume_id,match_rate
+    bool writeCSV(const string &filename, const SkillMatrix &matrix) const;
+};
+
+template <class JobStore, class ResumeStore>
+void SkillMatrix::build(const JobStore &jobs, const ResumeStore &resumes) {
+    for (typename JobStore::const_iterator j = jobs.begin(); j != jobs.end(); ++j) addJob(j->jobID, j->keywords);
+    for (typename ResumeStore::const_iterator r = resumes.begin(); r != resumes.end(); ++r)
+        addResume(r->resumeID, r->keywords);
+    finalize();
+}
+
+#endif
@@ -0,0 +1,214 @@
+#include "skill_ontology.h"
+#include "trace.h"
+#include "utility.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <unordered_map>
+#include <cctype>
+#include <cstdlib>
+using namespace std;
+
+// Compiled rules: every known spelling (lowercase) -> canonical skill ID
+struct CompiledOntology {
+    unordered_map<string, int> ids;
+    vector<string> names;                    // ID -> canonical display name
+    vector<vector<SkillOntology::Edge> > partial;   // parent ID -> its sources
+    int aliases;
+    int edges;
+};
+
+static CompiledOntology rules = { unordered_map<string, int>(), vector<string>(), vector<vector<SkillOntology::Edge> >(), 0, 0 };
+static int loadedVersion = 0;
+static string loadedFile;
+
+// ID of a canonical name, created on first mention
+static int internSkill(CompiledOntology &out, const string &name) {
+    string key = lowercase(name);
+    unordered_map<string, int>::iterator it = out.ids.find(key);
+    if (it != out.ids.end()) return it->second;
+    int id = (int)out.names.size();
+    out.ids[key] = id;
+    out.names.push_back(name);
+    out.partial.push_back(vector<SkillOntology::Edge>());
+    return id;
+}
+
+// ---------------- loading ----------------
+bool SkillOntology::load(const string &filename) {
+    TRACE_SCOPE("loadOntology");
+    ifstream file(filename.c_str());
+    if (!file.is_open()) {
+        cout << "Skill ontology: cannot open " << filename << "\n";
+        return false;
+    }
+
+    CompiledOntology next = { unordered_map<string, int>(), vector<string>(), vector<vector<Edge> >(), 0, 0 };
+    vector<pair<string, string> > aliases;   // alias, canonical: applied after every canonical is known
+    struct PendingEdge { string child, parent; double weight; };
+    vector<PendingEdge> edges;
+
+    string line;
+    for (int number = 1; getline(file, line); ++number) {
+        size_t comment = line.find('#');
+        if (comment != string::npos) line.erase(comment);
+        line = trimmed(line);
+        if (line.empty()) continue;
+
+        size_t equals = line.find('=');
+        size_t arrow = line.find('>');
+        if (equals != string::npos) {
+            string name = trimmed(line.substr(0, equals));
+            if (name.empty()) {
+                cout << "Skill ontology line " << number << ": missing canonical name\n";
+                return false;
+            }
+            internSkill(next, name);
+            stringstream list(line.substr(equals + 1));
+            string alias;
+            while (getline(list, alias, ',')) {
+                alias = trimmed(alias);
+                if (!alias.empty()) aliases.push_back(make_pair(alias, name));
+            }
+        } else if (arrow != string::npos) {
+            size_t colon = line.find(':', arrow);
+            PendingEdge edge;
+            edge.child = trimmed(line.substr(0, arrow));
+            edge.parent = trimmed(line.substr(arrow + 1, colon == string::npos ? string::npos : colon - arrow - 1));
+            edge.weight = (colon == string::npos) ? 0.5 : atof(line.c_str() + colon + 1);
+            if (edge.child.empty() || edge.parent.empty() || edge.weight <= 0 || edge.weight > 1) {
+                cout << "Skill ontology line " << number << ": expected \"Child > Parent : weight\" with 0 < weight <= 1\n";
+                return false;
+            }
+            edges.push_back(edge);
+        } else {
+            cout << "Skill ontology line " << number << ": expected \"Name = aliases\" or \"Child > Parent : weight\"\n";
+            return false;
+        }
+    }
+
+    for (size_t i = 0; i < aliases.size(); ++i) {
+        string key = lowercase(aliases[i].first);
+        int target = internSkill(next, aliases[i].second);
+        unordered_map<string, int>::iterator it = next.ids.find(key);
+        if (it != next.ids.end() && it->second != target) {
+            cout << "Skill ontology: \"" << aliases[i].first << "\" is both " << next.names[it->second]
+                 << " and " << aliases[i].second << "\n";
+            return false;
+        }
+        next.ids[key] = target;
+        next.aliases++;
+    }
+
+    // Edges may name skills by alias; store them under canonical names
+    for (size_t i = 0; i < edges.size(); ++i) {
+        unordered_map<string, int>::iterator child = next.ids.find(lowercase(edges[i].child));
+        int childID = (child != next.ids.end()) ? child->second : internSkill(next, edges[i].child);
+        unordered_map<string, int>::iterator parent = next.ids.find(lowercase(edges[i].parent));
+        int parentID = (parent != next.ids.end()) ? parent->second : internSkill(next, edges[i].parent);
+        Edge edge = { next.names[childID], edges[i].weight };
+        next.partial[parentID].push_back(edge);
+        next.edges++;
+    }
+    for (size_t p = 0; p < next.partial.size(); ++p)   // highest credit first
+        sort(next.partial[p].begin(), next.partial[p].end(), [](const Edge &a, const Edge &b) {
+            return a.weight > b.weight;
+        });
+
+    rules = next;
+    loadedVersion++;
+    loadedFile = filename;
+    return true;
+}
+
+void SkillOntology::clear() {
+    CompiledOntology none = { unordered_map<string, int>(), vector<string>(), vector<vector<Edge> >(), 0, 0 };
+    rules = none;
+    loadedVersion++;
+    loadedFile.clear();
+}
+
+bool SkillOntology::empty() {
+    return rules.names.empty();
+}
+
+int SkillOntology::version() {
+    return loadedVersion;
+}
+
+const string& SkillOntology::source() {
+    return loadedFile;
+}
+
+// ---------------- lookups ----------------
+string SkillOntology::canonical(const string &skill) {
+    if (rules.names.empty()) return skill;
+    unordered_map<string, int>::const_iterator it = rules.ids.find(lowercase(trimmed(skill)));
+    return (it == rules.ids.end()) ? skill : rules.names[it->second];
+}
+
+void SkillOntology::canonicalize(string keywords[10]) {
+    if (rules.names.empty()) return;
+    int kept = 0;
+    for (int i = 0; i < 10; ++i) {
+        if (keywords[i].empty()) continue;
+        unordered_map<string, int>::const_iterator it = rules.ids.find(lowercase(keywords[i]));
+        string name = (it == rules.ids.end()) ? keywords[i] : rules.names[it->second];
+
+        bool repeated = false;   // "ML, Machine Learning" is one skill
+        for (int k = 0; k < kept && !repeated; ++k) repeated = (it != rules.ids.end()) && equalsIgnoreCase(keywords[k], name);
+        if (!repeated) keywords[kept++] = name;
+    }
+    for (int i = kept; i < 10; ++i) keywords[i].clear();
+}
+
+const vector<SkillOntology::Edge>* SkillOntology::partialSources(const string &skill) {
+    if (rules.edges == 0) return nullptr;
+    unordered_map<string, int>::const_iterator it = rules.ids.find(lowercase(skill));
+    if (it == rules.ids.end() || rules.partial[it->second].empty()) return nullptr;
+    return &rules.partial[it->second];
+}
+
+void SkillOntology::printReport() {
+    if (rules.names.empty()) {
+        cout << "Skill ontology: none loaded (exact skill matching)\n";
+        return;
+    }
+    cout << "Skill ontology: " << loadedFile << " (version " << loadedVersion << "), " << rules.names.size()
+         << " canonical skills, " << rules.aliases << " aliases, " << rules.edges << " partial-credit edges\n";
+}
+
+// ---------------- QuerySkills ----------------
+QuerySkills::QuerySkills(const string jobKeywords[10]) : keywords(jobKeywords), keywordCount(0), anyPartial(false) {
+    for (int i = 0; i < 10; ++i) {
+        partial[i] = jobKeywords[i].empty() ? nullptr : SkillOntology::partialSources(jobKeywords[i]);
+        if (partial[i]) anyPartial = true;
+        if (!jobKeywords[i].empty()) keywordCount++;
+    }
+}
+
+double QuerySkills::credit(const string resumeKeywords[10]) const {
+    double total = 0;
+    for (int a = 0; a < 10; ++a) {
+        if (keywords[a].empty()) continue;
+        bool found = false;
+        for (int b = 0; b < 10 && !found; ++b)
+            found = !resumeKeywords[b].empty() && equalsIgnoreCase(keywords[a], resumeKeywords[b]);
+        if (found) {
+            total += 1;
+            continue;
+        }
+        if (!anyPartial || !partial[a]) continue;
+
+        // Sources are sorted by weight, so the first one present is the best
+        const vector<SkillOntology::Edge> &sources = *partial[a];
+        for (size_t e = 0; e < sources.size() && !found; ++e)
+            for (int b = 0; b < 10 && !found; ++b)
+                if (equalsIgnoreCase(sources[e].child, resumeKeywords[b])) {
+                    total += sources[e].weight;
+                    found = true;
+                }
+    }
+    return total;
+}
@@ -0,0 +1,71 @@
+#ifndef SKILL_ONTOLOGY_H
+#define SKILL_ONTOLOGY_H
+
+#include <string>
+#include <vector>
+using namespace std;
+
+// Skill synonyms and hierarchy, read from a rule file (data/skill_ontology.txt):
+//   Machine Learning = ML, machine-learning     aliases -> canonical name
+//   AWS > Cloud : 0.5                           partial credit: a resume
+//                                               listing AWS earns 0.5 of a
+//                                               job keyword Cloud
+// Names are case-insensitive; '#' starts a comment.
+//
+// The rules are compiled into canonical skill IDs and applied where text
+// enters: the keyword extractors rewrite every alias to its canonical name
+// at ingest, and query terms are canonicalized once per query. Matching
+// itself keeps comparing keywords exactly, so synonyms cost nothing per
+// pair. Partial-credit edges are looked up once per job (QuerySkills) and
+// are only consulted for job keywords that did not match exactly.
+//
+// load() may be called again at any time; the containers then re-extract
+// their keywords (reextractKeywords()) so stored records follow the new rules.
+class SkillOntology {
+public:
+    struct Edge {
+        string child;       // canonical name of the more specific skill
+        double weight;      // credit it earns towards the parent, 0..1
+    };
+
+    // Replace the rules with the file's; false (rules unchanged) on a bad file
+    static bool load(const string &filename);
+    static void clear();
+
+    static bool empty();
+    static int version();   // bumps on every successful load
+    static const string& source();   // file of the current rules ("" if none)
+
+    // Canonical display name of a skill (the skill itself when unknown)
+    static string canonical(const string &skill);
+
+    // Rewrite aliases in place; keywords that become repeats are dropped
+    // and the rest moved up so the slots stay contiguous
+    static void canonicalize(string keywords[10]);
+
+    // Skills that earn partial credit towards this one (nullptr if none)
+    static const vector<Edge>* partialSources(const string &skill);
+
+    static void printReport();
+};
+
+// The keywords of one job, with their partial-credit sources resolved once,
+// scored against any number of resumes
+class QuerySkills {
+private:
+    const string *keywords;
+    const vector<SkillOntology::Edge> *partial[10];
+    int keywordCount;
+    bool anyPartial;
+
+public:
+    explicit QuerySkills(const string jobKeywords[10]);
+
+    int size() const { return keywordCount; }
+
+    // Job keywords found in the resume (exact, case-insensitive), plus the
+    // best partial credit for each one that was not
+    double credit(const string resumeKeywords[10]) const;
+};
+
+#endif
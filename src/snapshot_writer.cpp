@@ -0,0 +1,160 @@
+#include "snapshot_writer.h"
+#include "metrics.h"
+#include "trace.h"
+#include <iostream>
+#include <cstdio>
+#include <cerrno>
+#include <cstring>
+#include <chrono>
+#include <vector>
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+using namespace std;
+using namespace std::chrono;
+
+static const size_t WRITE_BUFFER = 1 << 20;
+
+SnapshotWriter::SnapshotWriter() : stopping(false) {
+    worker = thread(&SnapshotWriter::run, this);
+}
+
+SnapshotWriter::~SnapshotWriter() {
+    {
+        lock_guard<mutex> guard(lock);
+        stopping = true;
+    }
+    wake.notify_one();
+    worker.join();   // run() drains the queue before it returns
+}
+
+SnapshotWriter& SnapshotWriter::instance() {
+    // The writer records latencies until it is destroyed, so the registry
+    // must be constructed first (and therefore destroyed after it)
+    MetricsRegistry::instance();
+    static SnapshotWriter writer;
+    return writer;
+}
+
+long long SnapshotWriter::submit(const string &filename, string content) {
+    shared_ptr<const string> snapshot = make_shared<const string>(std::move(content));
+    long long generation;
+    {
+        lock_guard<mutex> guard(lock);
+        Status &s = statuses[filename];
+        generation = ++s.submitted;
+        map<string, Pending>::iterator queued = pending.find(filename);
+        if (queued != pending.end()) s.coalesced++;
+        Pending next = { snapshot, generation };
+        pending[filename] = next;
+    }
+    wake.notify_one();
+    return generation;
+}
+
+void SnapshotWriter::flush() {
+    unique_lock<mutex> guard(lock);
+    idle.wait(guard, [this] {
+        if (!pending.empty()) return false;
+        for (map<string, Status>::iterator it = statuses.begin(); it != statuses.end(); ++it)
+            if (it->second.writing) return false;
+        return true;
+    });
+}
+
+void SnapshotWriter::run() {
+    Tracer::nameThread("snapshot writer");
+    unique_lock<mutex> guard(lock);
+    while (true) {
+        wake.wait(guard, [this] { return stopping || !pending.empty(); });
+        if (pending.empty()) break;   // only reached when stopping
+
+        string filename = pending.begin()->first;
+        Pending job = pending.begin()->second;
+        pending.erase(pending.begin());
+        statuses[filename].writing = true;
+
+        guard.unlock();
+        auto start = high_resolution_clock::now();
+        string error;
+        bool ok;
+        {
+            TRACE_SCOPE("snapshotWrite");
+            ok = writeAtomically(filename, *job.content, error);
+        }
+        recordLatency("snapshot_write", "background", duration_cast<microseconds>(high_resolution_clock::now() - start).count());
+        guard.lock();
+
+        Status &s = statuses[filename];
+        s.writing = false;
+        if (ok) {
+            s.written = job.generation;
+            s.lastError.clear();
+        } else {
+            s.lastError = error;
+            MetricsRegistry::instance().increment("snapshot_failures", "background");
+        }
+        if (pending.empty()) idle.notify_all();
+    }
+    idle.notify_all();
+}
+
+bool SnapshotWriter::writeAtomically(const string &filename, const string &content, string &error) {
+    string temp = filename + ".tmp";
+    FILE *file = fopen(temp.c_str(), "wb");
+    if (!file) {
+        error = "cannot open " + temp + ": " + strerror(errno);
+        return false;
+    }
+
+    vector<char> buffer(WRITE_BUFFER);
+    setvbuf(file, buffer.data(), _IOFBF, buffer.size());
+    bool ok = fwrite(content.data(), 1, content.size(), file) == content.size() && fflush(file) == 0;
+#ifdef _WIN32
+    ok = ok && _commit(_fileno(file)) == 0;
+#else
+    ok = ok && fsync(fileno(file)) == 0;
+#endif
+    if (fclose(file) != 0) ok = false;
+    if (!ok) {
+        error = "write to " + temp + " failed: " + strerror(errno);
+        remove(temp.c_str());
+        return false;
+    }
+
+#ifdef _WIN32
+    ok = MoveFileExA(temp.c_str(), filename.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    ok = rename(temp.c_str(), filename.c_str()) == 0;
+#endif
+    if (!ok) {
+        error = "rename to " + filename + " failed: " + strerror(errno);
+        remove(temp.c_str());
+    }
+    return ok;
+}
+
+SnapshotWriter::Status SnapshotWriter::status(const string &filename) {
+    lock_guard<mutex> guard(lock);
+    return statuses[filename];
+}
+
+void SnapshotWriter::printStatus() {
+    lock_guard<mutex> guard(lock);
+    if (statuses.empty()) {
+        cout << "Nothing has been saved yet.\n";
+        return;
+    }
+    for (map<string, Status>::const_iterator it = statuses.begin(); it != statuses.end(); ++it) {
+        const Status &s = it->second;
+        cout << it->first << ": generation " << s.written << " of " << s.submitted << " on disk";
+        if (s.writing) cout << ", writing";
+        if (pending.count(it->first)) cout << ", 1 queued";
+        if (s.coalesced) cout << ", " << s.coalesced << " coalesced";
+        if (!s.lastError.empty()) cout << ", LAST WRITE FAILED (" << s.lastError << ")";
+        cout << "\n";
+    }
+}
@@ -0,0 +1,63 @@
+#ifndef SNAPSHOT_WRITER_H
+#define SNAPSHOT_WRITER_H
+
+#include <string>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+using namespace std;
+
+// Background CSV persistence. saveToCSV() formats the records into one
+// immutable string on the caller's thread and hands it over here; a single
+// writer thread streams it to "<file>.tmp" with one large buffered write,
+// syncs it and renames it over the real file, so a crash mid-save leaves
+// either the old CSV or the new one, never a truncated file. A newer
+// snapshot of the same file replaces one that has not been picked up yet.
+class SnapshotWriter {
+public:
+    struct Status {
+        long long submitted;   // generations handed over
+        long long written;     // generation currently on disk
+        long long coalesced;   // snapshots replaced before being written
+        bool writing;
+        string lastError;      // empty when the last write succeeded
+    };
+
+private:
+    struct Pending {
+        shared_ptr<const string> content;
+        long long generation;
+    };
+
+    map<string, Pending> pending;    // per file, newest snapshot only
+    map<string, Status> statuses;
+    mutex lock;
+    condition_variable wake;         // writer: work arrived / stopping
+    condition_variable idle;         // flush(): queue drained
+    bool stopping;
+    thread worker;
+
+    SnapshotWriter();
+    SnapshotWriter(const SnapshotWriter&);
+    SnapshotWriter& operator=(const SnapshotWriter&);
+
+    void run();
+    static bool writeAtomically(const string &filename, const string &content, string &error);
+
+public:
+    ~SnapshotWriter();
+    static SnapshotWriter& instance();
+
+    // Queue a snapshot; returns its generation number for the file
+    long long submit(const string &filename, string content);
+
+    // Block until every queued snapshot is on disk
+    void flush();
+
+    Status status(const string &filename);
+    void printStatus();
+};
+
+#endif
@@ -0,0 +1,236 @@
+#include "text_codec.h"
+#include "trace.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <unordered_map>
+#include <atomic>
+#include <chrono>
+using namespace std;
+using namespace std::chrono;
+
+static vector<string> entries;                   // code -> word run
+static unordered_map<string, int> codes;         // word run -> code
+static size_t entryBytes = 0;
+static atomic<bool> active(false);
+
+static atomic<long long> packedRecords(0), rawBytes(0), packedBytes(0);
+static atomic<long long> decodes(0), decodedBytes(0), decodeNanos(0);
+
+// ---------------- training ----------------
+bool TextCodec::train(const vector<string> &samples) {
+    TRACE_SCOPE("trainDictionary");
+    if (active) return true;   // packed text already depends on the current dictionary
+
+    // Count every run of 1..MAX_RUN_WORDS words that is followed by a space
+    unordered_map<string, int> counts;
+    for (size_t s = 0; s < samples.size(); ++s) {
+        const string &text = samples[s];
+        vector<size_t> starts;   // word starts; a word ends at the next space
+        for (size_t i = 0; i < text.size(); ++i)
+            if (text[i] != ' ' && (i == 0 || text[i - 1] == ' ')) starts.push_back(i);
+
+        for (size_t w = 0; w < starts.size(); ++w) {
+            size_t end = starts[w];
+            for (int n = 0; n < MAX_RUN_WORDS; ++n) {
+                end = text.find(' ', end);
+                if (end == string::npos) break;
+                ++end;   // keep the space
+                counts[text.substr(starts[w], end - starts[w])]++;
+                if (w + n + 1 >= starts.size() || starts[w + n + 1] != end) break;   // double space
+            }
+        }
+    }
+
+    // A run seen c times saves about c * (length - 2) bytes as a 2-byte code
+    vector<pair<long long, string> > ranked;
+    for (unordered_map<string, int>::const_iterator it = counts.begin(); it != counts.end(); ++it)
+        if (it->second > 1 && it->first.size() > 2)
+            ranked.push_back(make_pair((long long)it->second * ((long long)it->first.size() - 2), it->first));
+    if (ranked.empty()) return false;
+    sort(ranked.begin(), ranked.end(), [](const pair<long long, string> &a, const pair<long long, string> &b) {
+        return a.first != b.first ? a.first > b.first : a.second < b.second;
+    });
+    if (ranked.size() > (size_t)MAX_ENTRIES) ranked.resize(MAX_ENTRIES);
+
+    entries.clear();
+    codes.clear();
+    entryBytes = 0;
+    for (size_t i = 0; i < ranked.size(); ++i) {
+        codes[ranked[i].second] = (int)entries.size();   // most valuable runs get 1-byte codes
+        entries.push_back(ranked[i].second);
+        entryBytes += ranked[i].second.size();
+    }
+    active = true;
+    return true;
+}
+
+bool TextCodec::trainFromFiles(const vector<string> &files, int maxLines) {
+    vector<string> samples;
+    for (size_t f = 0; f < files.size(); ++f) {
+        ifstream file(files[f]);
+        string line;
+        getline(file, line);   // header
+        for (int n = 0; n < maxLines && getline(file, line); ++n)
+            if (!line.empty()) samples.push_back(line);
+    }
+    return train(samples);
+}
+
+bool TextCodec::enabled() {
+    return active;
+}
+
+int TextCodec::dictionaryEntries() {
+    return (int)entries.size();
+}
+
+size_t TextCodec::dictionaryBytes() {
+    return entryBytes;
+}
+
+// ---------------- encoding ----------------
+static inline void putLiteral(string &out, unsigned char c) {
+    if (c == 0 || c >= 0x80) out += '\0';
+    out += (char)c;
+}
+
+void TextCodec::compress(const string &text, string &out) {
+    out.clear();
+    size_t n = text.size();
+    for (size_t v = n; ; v >>= 7) {   // varint raw length
+        if (v < 0x80) { out += (char)v; break; }
+        out += (char)((v & 0x7f) | 0x80);
+    }
+
+    string run;
+    size_t i = 0;
+    while (i < n) {
+        // Longest known run of whole words starting here
+        size_t ends[MAX_RUN_WORDS];
+        int words = 0;
+        for (size_t end = i; words < MAX_RUN_WORDS; ) {
+            end = text.find(' ', end);
+            if (end == string::npos || end == i) break;
+            ends[words++] = ++end;
+            if (end < n && text[end] == ' ') break;
+        }
+        int code = -1;
+        size_t length = 0;
+        for (int w = words - 1; w >= 0 && code < 0; --w) {
+            run.assign(text, i, ends[w] - i);
+            unordered_map<string, int>::const_iterator it = codes.find(run);
+            if (it != codes.end()) {
+                code = it->second;
+                length = ends[w] - i;
+            }
+        }
+
+        if (code >= 0) {
+            if (code < SHORT_CODES) {
+                out += (char)(0x80 + code);
+            } else {
+                out += (char)(0xc0 + ((code - SHORT_CODES) >> 8));
+                out += (char)((code - SHORT_CODES) & 0xff);
+            }
+            i += length;
+            continue;
+        }
+
+        // Unknown word: copy it and its space as they are
+        size_t end = text.find(' ', i);
+        end = (end == string::npos) ? n : end + 1;
+        for (; i < end; ++i) putLiteral(out, (unsigned char)text[i]);
+    }
+
+    packedRecords++;
+    rawBytes += n;
+    packedBytes += out.size();
+}
+
+// ---------------- decoding ----------------
+void TextCodec::decompress(const string &packed, string &out) {
+    auto start = steady_clock::now();
+    const unsigned char *ip = (const unsigned char*)packed.data();
+    const unsigned char *end = ip + packed.size();
+
+    size_t rawLength = 0;
+    for (int shift = 0; ip < end; shift += 7) {
+        unsigned char b = *ip++;
+        rawLength |= (size_t)(b & 0x7f) << shift;
+        if (!(b & 0x80)) break;
+    }
+
+    size_t base = out.size();
+    out.reserve(base + rawLength);
+    while (ip < end) {
+        unsigned char b = *ip++;
+        if (b >= 0xc0) {
+            size_t code = SHORT_CODES + ((size_t)(b - 0xc0) << 8) + (ip < end ? *ip++ : 0);
+            if (code < entries.size()) out += entries[code];
+        } else if (b >= 0x80) {
+            out += entries[b - 0x80];
+        } else if (b == 0) {
+            if (ip < end) out += (char)*ip++;
+        } else {
+            out += (char)b;
+        }
+    }
+
+    decodes++;
+    decodedBytes += out.size() - base;
+    decodeNanos += duration_cast<nanoseconds>(steady_clock::now() - start).count();
+}
+
+// ---------------- report ----------------
+TextCodec::Stats TextCodec::stats() {
+    Stats s = { packedRecords, rawBytes, packedBytes, decodes, decodedBytes, decodeNanos };
+    return s;
+}
+
+void TextCodec::printReport() {
+    if (!active) {
+        cout << "Description compression: off (start with --compress)\n";
+        return;
+    }
+    Stats s = stats();
+    cout << "Description compression: on, " << entries.size() << "-entry trained dictionary ("
+         << entryBytes / 1024 << " KB)\n";
+    cout << "  " << s.packedRecords << " descriptions packed: " << s.rawBytes / 1024 << " KB -> "
+         << s.packedBytes / 1024 << " KB (ratio " << (s.packedBytes ? (double)s.rawBytes / s.packedBytes : 0.0)
+         << "x)\n";
+    cout << "  " << s.decodes << " decoded on demand, " << s.decodedBytes / 1024 << " KB";
+    if (s.decodeNanos > 0)
+        cout << " at " << (s.decodedBytes * 1000.0 / s.decodeNanos) << " MB/s";
+    cout << "\n";
+}
+
+// ---------------- PackedText ----------------
+void PackedText::pack() {
+    if (packed || !TextCodec::enabled()) return;
+    string compressed;
+    TextCodec::compress(bytes, compressed);
+    compressed.shrink_to_fit();   // appends left spare capacity
+    bytes.swap(compressed);   // the plain buffer is freed with compressed
+    packed = true;
+}
+
+string PackedText::str() const {
+    if (!packed) return bytes;
+    string text;
+    TextCodec::decompress(bytes, text);
+    return text;
+}
+
+void PackedText::appendTo(string &out) const {
+    if (packed) TextCodec::decompress(bytes, out);
+    else out += bytes;
+}
+
+ostream& operator<<(ostream &out, const PackedText &text) {
+    static thread_local string scratch;   // reused: printing allocates nothing once warm
+    scratch.clear();
+    text.appendTo(scratch);
+    return out << scratch;
+}
@@ -0,0 +1,89 @@
+#ifndef TEXT_CODEC_H
+#define TEXT_CODEC_H
+
+#include <string>
+#include <vector>
+#include <ostream>
+using namespace std;
+
+// Optional in-memory compression of record descriptions (run with:
+//   main --compress ...)
+//
+// Descriptions are short (a few hundred bytes) and are made of the same
+// phrases ("Experienced professional skilled in", "needed with experience
+// in"), skill names and filler words over and over, so a general-purpose
+// compressor has too little input per record to learn them. TextCodec
+// instead trains one shared dictionary from a sample of the data files: the
+// runs of 1..4 words (each with its trailing space) that save the most
+// bytes. Every description is then written as dictionary codes wherever a
+// run is known, longest first, and as plain bytes elsewhere:
+//   0x01..0x7f         literal byte
+//   0x80..0xbf         entry 0..63 (the most valuable runs)
+//   0xc0..0xff, next   entry 64..16447
+//   0x00, next         escaped literal (bytes >= 0x80 and NUL)
+// preceded by the raw length as a varint so decoding allocates once.
+class TextCodec {
+public:
+    static const int SHORT_CODES = 64;
+    static const int MAX_ENTRIES = SHORT_CODES + 64 * 256;
+    static const int MAX_RUN_WORDS = 4;
+
+    struct Stats {
+        long long packedRecords;
+        long long rawBytes;          // text handed to compress()
+        long long packedBytes;       // what it became
+        long long decodes;
+        long long decodedBytes;
+        long long decodeNanos;
+    };
+
+    // Build the dictionary from sample descriptions and turn compression on.
+    // Must run before any description is packed; the dictionary never changes.
+    static bool train(const vector<string> &samples);
+
+    // Same, sampling up to maxLines lines of each CSV (header skipped)
+    static bool trainFromFiles(const vector<string> &files, int maxLines);
+
+    static bool enabled();
+    static int dictionaryEntries();
+    static size_t dictionaryBytes();
+
+    static void compress(const string &text, string &out);
+    static void decompress(const string &packed, string &out);   // appends to out
+
+    static Stats stats();
+    static void printReport();
+};
+
+// A description as stored in the containers: plain text until pack() is
+// called, and from then on TextCodec output when compression is enabled.
+// Scoring never needs it; it is decoded only where text is shown, saved or
+// indexed (str(), appendTo(), operator<<).
+class PackedText {
+private:
+    string bytes;     // plain text, or TextCodec output when packed
+    bool packed;
+
+public:
+    PackedText() : packed(false) {}
+    PackedText(const string &text) : bytes(text), packed(false) {}
+    PackedText(string &&text) : bytes(std::move(text)), packed(false) {}
+
+    PackedText& operator=(const string &text) { bytes = text; packed = false; return *this; }
+    PackedText& operator=(string &&text) { bytes = std::move(text); packed = false; return *this; }
+
+    // Compress in place (no-op when compression is off or already packed)
+    void pack();
+
+    string str() const;
+    void appendTo(string &out) const;
+    explicit operator string() const { return str(); }
+
+    bool isPacked() const { return packed; }
+    bool empty() const { return bytes.empty(); }
+    size_t storedBytes() const { return bytes.size(); }
+};
+
+ostream& operator<<(ostream &out, const PackedText &text);
+
+#endif
@@ -0,0 +1,90 @@
+#include "threshold_query.h"
+#include "posting_ops.h"
+#include "utility.h"
+#include "trace.h"
+#include "query_arena.h"
+#include <algorithm>
+#include <cmath>
+#include <cctype>
+using namespace std;
+
+ThresholdQuery::ThresholdQuery(const SkillIndex &idx, const string jobKeywords[10], double minRate)
+    : index(idx), termCount(0), keywordCount(0), unindexed(0), minShared(0) {
+    // Repeated job keywords each count towards the rate, so a skill listed
+    // twice weighs 2 (keywordMatchCount scores it the same way). At most 10
+    // skills: fixed slots and a linear search, nothing from the heap.
+    string keys[10];
+    for (int i = 0; i < 10; ++i) {
+        if (jobKeywords[i].empty()) continue;
+        keywordCount++;
+        string key = lowercase(jobKeywords[i]);
+        if (isStopWord(key)) { unindexed++; continue; }
+        int k = 0;
+        while (k < termCount && keys[k] != key) ++k;
+        if (k < termCount) { terms[k].weight++; continue; }
+        keys[termCount].swap(key);
+        terms[termCount].postings = &index.getPostings(index.lookup(keys[termCount]));   // unknown skills get the shared empty list
+        terms[termCount].weight = 1;
+        termCount++;
+    }
+    sort(terms, terms + termCount, [](const Term &a, const Term &b) {
+        return a.postings->cardinality() < b.postings->cardinality();
+    });
+
+    if (keywordCount > 0 && minRate > 0) {
+        minShared = (int)ceil(minRate * keywordCount / 100.0 - 1e-9);
+        if (minShared < 1) minShared = 1;
+    }
+}
+
+ThresholdQuery::Stats ThresholdQuery::run(ThresholdSink &sink) const {
+    TRACE_SCOPE("thresholdQuery");
+    Stats stats = { termCount, 0, 0, 0, 0 };
+    int cutoff = minShared - unindexed;   // what the index alone must show
+    if (cutoff <= 0) return stats;
+
+    // Shortest lists until the weight left over cannot reach the cutoff
+    int rest = 0;
+    for (int t = 0; t < termCount; ++t) rest += terms[t].weight;
+    if (rest < cutoff) return stats;      // even a record with every skill falls short
+    int merged = 0;
+    while (merged < termCount && rest >= cutoff) rest -= terms[merged++].weight;
+    stats.merged = merged;
+
+    // Expanded lists are query scratch: from the arena inside a QueryScope
+    vector<int, ArenaAllocator<int> > lists[10];
+    size_t cursor[10] = { 0 };
+    {
+        TRACE_SCOPE("expand");
+        for (int t = 0; t < merged; ++t) {
+            lists[t].resize(terms[t].postings->cardinality());
+            if (!lists[t].empty()) terms[t].postings->toArray(&lists[t][0]);
+        }
+    }
+
+    // k-way merge by smallest head (k <= 10, a linear scan beats a heap)
+    while (true) {
+        int id = -1;
+        for (int t = 0; t < merged; ++t)
+            if (cursor[t] < lists[t].size() && (id < 0 || lists[t][cursor[t]] < id)) id = lists[t][cursor[t]];
+        if (id < 0) break;
+
+        int shared = 0;
+        for (int t = 0; t < merged; ++t)
+            if (cursor[t] < lists[t].size() && lists[t][cursor[t]] == id) { shared += terms[t].weight; cursor[t]++; }
+        stats.candidates++;
+
+        // Probe the longer lists, giving up once they cannot close the gap
+        int unprobed = rest;
+        for (int t = merged; t < termCount && shared + unprobed >= cutoff; ++t) {
+            stats.probes++;
+            if (terms[t].postings->contains(id)) shared += terms[t].weight;
+            unprobed -= terms[t].weight;
+        }
+        if (shared < cutoff) continue;
+
+        stats.matches++;
+        sink.accept(id, shared);
+    }
+    return stats;
+}
@@ -0,0 +1,71 @@
+#ifndef THRESHOLD_QUERY_H
+#define THRESHOLD_QUERY_H
+
+#include <string>
+#include <vector>
+#include "skill_index.h"
+using namespace std;
+
+// Receives the records of a ThresholdQuery as they qualify, in ascending ID
+// order. shared is the number of job keywords found through the index.
+class ThresholdSink {
+public:
+    virtual ~ThresholdSink() {}
+    virtual void accept(int id, int shared) = 0;
+};
+
+// "Every resume with at least X% of the job's keywords", answered from the
+// skill index without scoring the whole store.
+//
+// X% of k job keywords means at least T = ceil(X * k / 100) shared skills.
+// The job's posting lists are sorted shortest first; a record found in none
+// of the shortest lists can still reach T only through the others, so lists
+// are taken until the weight left over is below T. Only those lists are
+// merged (with a count per ID); every ID they produce is then probed in the
+// remaining lists and dropped as soon as the lists still unprobed cannot
+// lift it to T. For an 80% screen of a 5-skill job that merges the two
+// rarest lists and never looks at resumes outside them.
+class ThresholdQuery {
+public:
+    struct Stats {
+        int lists;              // distinct job skills with a posting list
+        int merged;             // of which merged (the rest are probed)
+        long long candidates;   // IDs produced by the merge
+        long long probes;       // contains() calls on the probed lists
+        long long matches;      // IDs handed to the sink
+    };
+
+private:
+    struct Term {
+        const CompressedPostings *postings;
+        int weight;             // times the skill appears in the job's keywords
+    };
+
+    const SkillIndex &index;
+    Term terms[10];             // shortest posting list first
+    int termCount;
+    int keywordCount;           // non-empty job keywords (the rate's denominator)
+    int unindexed;              // job keywords the index never holds (stop words)
+    int minShared;
+
+public:
+    ThresholdQuery(const SkillIndex &index, const string jobKeywords[10], double minRate);
+
+    int getKeywordCount() const { return keywordCount; }
+    int getMinShared() const { return minShared; }
+    double rateOf(int shared) const { return keywordCount ? shared * 100.0 / keywordCount : 0.0; }
+
+    // Job keywords the index cannot answer for. When non-zero, shared counts
+    // can be short by up to this many and the caller must re-score records
+    // (keywordMatchCount) before trusting them; run() already lowers its
+    // cutoff by the same amount so nothing qualifying is pruned.
+    int getUnindexed() const { return unindexed; }
+
+    // False when the cutoff is 0 (every record qualifies and the index
+    // cannot prune anything; scan the store instead)
+    bool canPrune() const { return minShared - unindexed > 0; }
+
+    Stats run(ThresholdSink &sink) const;
+};
+
+#endif
@@ -0,0 +1,110 @@
+#include "trace.h"
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <vector>
+#include <mutex>
+#include <chrono>
+using namespace std;
+using namespace std::chrono;
+
+atomic<bool> Tracer::active(false);
+
+struct TraceEvent {
+    const char *name;
+    const char *category;
+    long long start;
+    long long end;
+};
+
+struct ThreadBuffer {
+    int tid;
+    const char *threadName;
+    vector<TraceEvent> events;
+};
+
+// Buffers outlive their threads so spans from finished workers still
+// make it into the file; only registration takes the lock.
+static mutex registryLock;
+static vector<ThreadBuffer*> buffers;
+static steady_clock::time_point origin = steady_clock::now();
+static thread_local ThreadBuffer *localBuffer = nullptr;
+
+static ThreadBuffer* currentBuffer() {
+    if (!localBuffer) {
+        lock_guard<mutex> guard(registryLock);
+        localBuffer = new ThreadBuffer();
+        localBuffer->tid = (int)buffers.size() + 1;
+        localBuffer->threadName = nullptr;
+        localBuffer->events.reserve(4096);
+        buffers.push_back(localBuffer);
+    }
+    return localBuffer;
+}
+
+long long Tracer::nowNanos() {
+    return duration_cast<nanoseconds>(steady_clock::now() - origin).count();
+}
+
+void Tracer::start() {
+    active.store(true, memory_order_relaxed);
+}
+
+void Tracer::nameThread(const char *name) {
+    if (enabled()) currentBuffer()->threadName = name;
+}
+
+void Tracer::record(const char *name, const char *category, long long startNanos, long long endNanos) {
+    TraceEvent event = { name, category, startNanos, endNanos };
+    currentBuffer()->events.push_back(event);
+}
+
+static void writeMicros(ostream &out, long long nanos) {
+    out << nanos / 1000 << '.' << setw(3) << setfill('0') << nanos % 1000 << setfill(' ');
+}
+
+bool Tracer::stop(const string &filename) {
+    active.store(false, memory_order_relaxed);
+
+    ofstream out(filename);
+    if (!out.is_open()) return false;
+
+    lock_guard<mutex> guard(registryLock);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    for (size_t b = 0; b < buffers.size(); ++b) {
+        const ThreadBuffer &buffer = *buffers[b];
+        const char *threadName = buffer.threadName ? buffer.threadName : (buffer.tid == 1 ? "main" : "worker");
+        out << (first ? "" : ",\n")
+            << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer.tid
+            << ",\"args\":{\"name\":\"" << threadName << "\"}}";
+        first = false;
+
+        for (size_t e = 0; e < buffer.events.size(); ++e) {
+            const TraceEvent &event = buffer.events[e];
+            out << ",\n{\"name\":\"" << event.name << "\",\"cat\":\"" << event.category
+                << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer.tid << ",\"ts\":";
+            writeMicros(out, event.start);
+            out << ",\"dur\":";
+            writeMicros(out, event.end - event.start);
+            out << "}";
+        }
+    }
+    out << "\n]}\n";
+    return true;
+}
+
+// ---------------- TraceSession ----------------
+TraceSession::TraceSession(const string &file) : filename(file) {
+    if (filename.empty()) return;
+    Tracer::start();
+    Tracer::nameThread("main");
+}
+
+TraceSession::~TraceSession() {
+    if (filename.empty()) return;
+    if (Tracer::stop(filename))
+        cout << "Trace written to " << filename << " (open in chrome://tracing or ui.perfetto.dev)\n";
+    else
+        cout << "Failed to write trace " << filename << "\n";
+}
@@ -0,0 +1,74 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <string>
+#include <atomic>
+#include <istream>
+using namespace std;
+
+// Chrome / Perfetto trace-event output (open the file in chrome://tracing
+// or ui.perfetto.dev). Spans are recorded into a buffer owned by the calling
+// thread, so worker threads never contend; the buffers are merged only when
+// the trace is written. While tracing is off a span costs one relaxed
+// atomic load. Build with -DNO_TRACING to compile the spans out entirely.
+class Tracer {
+private:
+    static atomic<bool> active;
+
+public:
+    static bool enabled() { return active.load(memory_order_relaxed); }
+
+    static void start();
+    // Writes every thread's spans; call after worker threads have joined
+    static bool stop(const string &filename);
+
+    static void nameThread(const char *name);       // label for the current thread's track
+    static long long nowNanos();
+    // name/category must outlive the trace (string literals)
+    static void record(const char *name, const char *category, long long startNanos, long long endNanos);
+};
+
+// Records one complete ("X") event covering its own lifetime
+class TraceSpan {
+private:
+    const char *name;
+    const char *category;
+    long long start;           // -1 when tracing was off at construction
+
+public:
+    explicit TraceSpan(const char *spanName, const char *spanCategory = "app")
+        : name(spanName), category(spanCategory), start(Tracer::enabled() ? Tracer::nowNanos() : -1) {}
+    ~TraceSpan() {
+        if (start >= 0) Tracer::record(name, category, start, Tracer::nowNanos());
+    }
+};
+
+// Starts tracing when given a file name and writes the trace when it goes
+// out of scope (main --trace trace.json)
+class TraceSession {
+private:
+    string filename;
+
+public:
+    explicit TraceSession(const string &file);
+    ~TraceSession();
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+#ifdef NO_TRACING
+#define TRACE_SCOPE(name)
+#define TRACE_SCOPE_CAT(name, category)
+#else
+#define TRACE_SCOPE(name) TraceSpan TRACE_CONCAT(traceSpan_, __LINE__)(name)
+#define TRACE_SCOPE_CAT(name, category) TraceSpan TRACE_CONCAT(traceSpan_, __LINE__)(name, category)
+#endif
+
+// getline() with its own "io" span, so file reading shows up on the timeline
+inline bool tracedGetline(istream &in, string &line) {
+    TRACE_SCOPE_CAT("getline", "io");
+    return (bool)getline(in, line);
+}
+
+#endif
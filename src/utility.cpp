@@ -1,8 +1,9 @@
 #include "utility.h"
 #include <fstream>
 #include <iostream>
-#include <windows.h>
-#include <psapi.h>
+#include <cctype>
+#include <unordered_set>
+#include "memory_accounting.h"
 
 using namespace std;
 
@@ -35,10 +36,61 @@ void displayMenu() {
     cout << "Enter your choice: ";
 }
 
+// Working set on Windows, VmRSS from /proc/self/status on Linux
 double getCurrentMemoryKB() {
-    PROCESS_MEMORY_COUNTERS_EX pmc;
-    if (GetProcessMemoryInfo(GetCurrentProcess(), (PROCESS_MEMORY_COUNTERS*)&pmc, sizeof(pmc))) {
-        return pmc.WorkingSetSize / 1024.0;
+    return (double)MemoryAccounting::residentKB();
+}
+
+std::string lowercase(const std::string &text) {
+    std::string lower = text;
+    for (size_t i = 0; i < lower.size(); ++i) lower[i] = (char)tolower((unsigned char)lower[i]);
+    return lower;
+}
+
+std::string trimmed(const std::string &text) {
+    size_t first = text.find_first_not_of(" \t\r");
+    if (first == std::string::npos) return "";
+    return text.substr(first, text.find_last_not_of(" \t\r") - first + 1);
+}
+
+bool equalsIgnoreCase(const std::string &a, const std::string &b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i)
+        if (tolower((unsigned char)a[i]) != tolower((unsigned char)b[i])) return false;
+    return true;
+}
+
+bool isStopWord(const std::string &word) {
+    static const char *list[] = {
+        "a", "about", "above", "after", "again", "against", "all", "also", "am", "an", "and",
+        "any", "are", "as", "at", "be", "because", "been", "before", "being", "below",
+        "between", "both", "but", "by", "can", "could", "did", "do", "does", "doing", "down",
+        "during", "each", "either", "else", "ever", "every", "few", "for", "from", "further",
+        "had", "has", "have", "having", "he", "her", "here", "hers", "herself", "him",
+        "himself", "his", "how", "i", "if", "in", "into", "is", "it", "its", "itself",
+        "just", "may", "me", "might", "more", "most", "mr", "mrs", "ms", "must", "my",
+        "myself", "no", "nor", "not", "now", "of", "off", "on", "once", "only", "or",
+        "other", "our", "ours", "ourselves", "out", "over", "own", "same", "she", "should",
+        "so", "some", "such", "than", "that", "the", "their", "theirs", "them",
+        "themselves", "then", "there", "these", "they", "this", "those", "through", "to",
+        "too", "under", "until", "up", "us", "very", "was", "we", "were", "what", "when",
+        "where", "which", "while", "who", "whom", "why", "will", "with", "would", "you",
+        "your", "yours", "yourself", "yourselves"
+    };
+    static const std::unordered_set<std::string> words(list, list + sizeof(list) / sizeof(list[0]));
+    return words.count(word) > 0;
+}
+
+void tokenizeText(const std::string &text, std::vector<std::string> &words) {
+    words.clear();
+    std::string current;
+    for (size_t i = 0; i <= text.size(); ++i) {
+        unsigned char c = (i < text.size()) ? (unsigned char)text[i] : ' ';
+        if (isalnum(c) || c == '+' || c == '#') {
+            current += (char)tolower(c);
+        } else if (!current.empty()) {
+            words.push_back(current);
+            current.clear();
+        }
     }
-    return 0.0;
-}
\ No newline at end of file
+}
@@ -2,9 +2,27 @@
 #define UTILITY_H
 
 #include <string>
+#include <vector>
 
 bool copyFile(const std::string &src, const std::string &dst);
 void displayMenu();
 double getCurrentMemoryKB();
 
+// Lowercase copy of text
+std::string lowercase(const std::string &text);
+
+// text without leading/trailing spaces, tabs and carriage returns
+std::string trimmed(const std::string &text);
+
+// Case-insensitive equality without building lowercase copies
+bool equalsIgnoreCase(const std::string &a, const std::string &b);
+
+// True for common English filler words ("the", "our", "mr", ...) that are
+// neither indexed nor meaningful as skills. Expects a lowercase word.
+bool isStopWord(const std::string &word);
+
+// Splits text into lowercase words (letters, digits, '+' and '#', so "C++"
+// and "C#" survive). Stop words are kept so positions stay true to the text.
+void tokenizeText(const std::string &text, std::vector<std::string> &words);
+
 #endif